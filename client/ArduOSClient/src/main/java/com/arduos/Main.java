@@ -4,6 +4,10 @@ import com.fazecast.jSerialComm.SerialPort;
 import streamprotocol.ParsedPacket;
 import streamprotocol.StreamProtocol;
 
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
 import java.nio.charset.StandardCharsets;
 import java.util.ArrayList;
 import java.util.Arrays;
@@ -25,6 +29,11 @@ public class Main {
     public static final int CMD_STDIN   = 100;
     public static final int CMD_STDOUT  = 101;
     public static final int CMD_STDERR  = 102;
+    public static final int CMD_PROF    = 110;
+    public static final int CMD_TRACE   = 111;
+    public static final int CMD_STATS   = 112;
+    public static final int CMD_MEMINFO = 113;
+    public static final int CMD_LIST    = 114;
     public static final int CMD_PING    = 200;
 
     // Payload Types
@@ -32,6 +41,19 @@ public class Main {
     public static final int PT_STRING   = 1;
 
     private static boolean interactiveMode = false; // [신규] 상호작용 모드 플래그
+    private static volatile Thread topThread = null;   // [신규] top 폴링 스레드
+    private static long[][] topPrevTasks = null;       // 직전 스냅샷 (태스크별 누적값)
+    private static long[] topPrevGlobal = null;        // 직전 스냅샷 (전역 누적값)
+    private static volatile String profDumpPath = "prof.bin"; // [신규] 프로파일 덤프 저장 경로
+    private static volatile String traceJsonPath = "trace.json"; // [신규] Chrome 트레이스 저장 경로
+    private static final List<String> traceEvents = new ArrayList<>(); // 누적된 트레이스 이벤트 (JSON)
+
+    // Trace.h TraceEvent 와 일치 (인덱스 = 이벤트 ID)
+    private static final String[] TRACE_EVENT_NAMES = {
+        "?", "task_switch", "syscall", "syscall", "refill", "seek", "sd_read", "sd_write",
+        "pkt_rx", "pkt_tx", "pkt_tx", "malloc", "free", "task_load", "task_exit",
+        "exec_cache"
+    };
 
     public static void main(String[] args) {
         System.out.println("=== ArduOS Client v2.0 ===");
@@ -142,6 +164,14 @@ public class Main {
     }
 
     private static void processInput(String input) {
+        // [신규] top 실행 중이면 아무 입력이나 top 종료
+        if (topThread != null) {
+            topThread.interrupt();
+            topThread = null;
+            System.out.println("top stopped.");
+            return;
+        }
+
         // [신규] 상호작용 모드 처리
         if (interactiveMode) {
             if (input.equalsIgnoreCase("exit_shell")) {
@@ -180,7 +210,7 @@ public class Main {
                 case "exec":
                 case "run":
                     if (arg.isEmpty()) {
-                        System.out.println("Usage: exec <filename>");
+                        System.out.println("Usage: exec <filename> [args] [> file | >> file] [2> file] [| <filename> [args]]");
                         return;
                     }
                     // "0 " 접두사 추가 (비동기 기본) -> 사용자가 직접 "1 file" 입력 가능
@@ -208,8 +238,72 @@ public class Main {
                 case "pwd":
                     packet = protocol.toBytes(new byte[0], StreamProtocol.UNFRAGED, (byte)PT_NONE, SYS_GETCWD);
                     break;
+                case "prof": {
+                    // prof start [ms] | prof stop | prof dump [file]
+                    String[] profArgs = arg.split("\\s+");
+                    String sub = profArgs[0].toLowerCase();
+                    String profCmd;
+                    if (sub.equals("start")) {
+                        profCmd = (profArgs.length > 1) ? "start " + profArgs[1] : "start";
+                    } else if (sub.equals("stop")) {
+                        profCmd = "stop";
+                    } else if (sub.equals("dump")) {
+                        profDumpPath = (profArgs.length > 1) ? profArgs[1] : "prof.bin";
+                        profCmd = "dump";
+                    } else {
+                        System.out.println("Usage: prof start [ms] | prof stop | prof dump [file]");
+                        return;
+                    }
+                    packet = protocol.toBytes(profCmd.getBytes(StandardCharsets.UTF_8), StreamProtocol.UNFRAGED, (byte)PT_STRING, CMD_PROF);
+                    break;
+                }
+                case "mem":
+                    packet = protocol.toBytes(new byte[0], StreamProtocol.UNFRAGED, (byte)PT_NONE, CMD_MEMINFO);
+                    break;
+                case "top": {
+                    // top [interval_ms] - 통계 스냅샷을 주기적으로 요청 (Enter 로 종료)
+                    long interval = 1000;
+                    if (!arg.isEmpty()) {
+                        try { interval = Long.parseLong(arg.trim()); } catch (NumberFormatException e) {}
+                    }
+                    final long period = Math.max(interval, 200);
+                    topPrevTasks = null;
+                    topPrevGlobal = null;
+                    topThread = new Thread(() -> {
+                        byte[] req = protocol.toBytes(new byte[0], StreamProtocol.UNFRAGED, (byte)PT_NONE, CMD_STATS);
+                        while (!Thread.currentThread().isInterrupted() && serialPort.isOpen()) {
+                            serialPort.writeBytes(req, req.length);
+                            try { Thread.sleep(period); } catch (InterruptedException e) { break; }
+                        }
+                    });
+                    topThread.setDaemon(true);
+                    topThread.start();
+                    System.out.println("top started (press Enter to stop).");
+                    return;
+                }
+                case "trace": {
+                    // trace mask <hex> | trace drain [file.json] | trace clear
+                    String[] traceArgs = arg.split("\\s+");
+                    String sub = traceArgs[0].toLowerCase();
+                    String traceCmd;
+                    if (sub.equals("mask") && traceArgs.length > 1) {
+                        traceCmd = "mask " + traceArgs[1];
+                    } else if (sub.equals("drain")) {
+                        if (traceArgs.length > 1) traceJsonPath = traceArgs[1];
+                        traceCmd = "drain";
+                    } else if (sub.equals("clear")) {
+                        synchronized (traceEvents) { traceEvents.clear(); }
+                        System.out.println("Trace events cleared.");
+                        return;
+                    } else {
+                        System.out.println("Usage: trace mask <hex> | trace drain [file.json] | trace clear");
+                        return;
+                    }
+                    packet = protocol.toBytes(traceCmd.getBytes(StandardCharsets.UTF_8), StreamProtocol.UNFRAGED, (byte)PT_STRING, CMD_TRACE);
+                    break;
+                }
                 default:
-                    System.out.println("Unknown command. (Try: ls, exec, cd, pwd, exit)");
+                    System.out.println("Unknown command. (Try: ls, exec, cd, pwd, top, mem, prof, trace, exit)");
                     return;
             }
 
@@ -237,13 +331,201 @@ public class Main {
                 System.err.print(payloadStr); // 아두이노 에러
                 System.err.flush();
                 break;
+            case CMD_PROF:
+                // 프로파일 덤프 (바이너리) -> 파일 저장 (vmtools.py prof 로 분석)
+                try (FileOutputStream out = new FileOutputStream(profDumpPath)) {
+                    out.write(p.getPayload());
+                    System.out.println("Profile saved to " + profDumpPath + " (" + p.getPayload().length + " bytes)");
+                } catch (IOException e) {
+                    System.err.println("Failed to save profile: " + e.getMessage());
+                }
+                break;
+            case CMD_TRACE:
+                saveTrace(p.getPayload());
+                break;
+            case CMD_STATS:
+                renderTop(p.getPayload());
+                break;
+            case CMD_MEMINFO:
+                renderMemInfo(p.getPayload());
+                break;
+            case CMD_LIST:
+                // ls 스트리밍 조각: 출력 후 ack (빈 조각 = 끝, ack 하지 않음)
+                if (p.getPayload().length > 0) {
+                    System.out.print(payloadStr);
+                    System.out.flush();
+                    byte[] ack = protocol.toBytes(new byte[0], StreamProtocol.UNFRAGED, (byte)PT_NONE, CMD_LIST);
+                    if (ack != null) serialPort.writeBytes(ack, ack.length);
+                }
+                break;
             default:
                 // System.out.println("[Rx] Cmd: " + cmd + ", Data: " + payloadStr);
                 break;
         }
     }
 
+    // 트레이스 드레인 패킷 -> Chrome/Perfetto trace JSON (누적 저장)
+    // 형식: [mask u8][lost u16][n u16] + n x [time u32][event u8][task u8][arg u16]
+    //   time: 상위 24비트 = ms, 하위 8비트 = 4us 단위
+    private static void saveTrace(byte[] data) {
+        if (data.length < 5) return;
+        int lost = (data[1] & 0xFF) | ((data[2] & 0xFF) << 8);
+        int n = (data[3] & 0xFF) | ((data[4] & 0xFF) << 8);
+
+        synchronized (traceEvents) {
+            for (int i = 0; i < n && 5 + i * 8 + 8 <= data.length; i++) {
+                int o = 5 + i * 8;
+                long time = (data[o] & 0xFFL) | ((data[o + 1] & 0xFFL) << 8) | ((data[o + 2] & 0xFFL) << 16) | ((data[o + 3] & 0xFFL) << 24);
+                int event = data[o + 4] & 0xFF;
+                int task = data[o + 5] & 0xFF;
+                int evArg = (data[o + 6] & 0xFF) | ((data[o + 7] & 0xFF) << 8);
+
+                long ts = (time >> 8) * 1000L + (time & 0xFF) * 4L;
+                String name = (event < TRACE_EVENT_NAMES.length) ? TRACE_EVENT_NAMES[event] : ("event_" + event);
+                String ph;
+                switch (event) {
+                    case 2: case 9: ph = "B"; name = name + " " + evArg; break; // syscall enter, tx begin
+                    case 3: case 10: ph = "E"; name = name + " " + evArg; break; // syscall exit, tx end
+                    default: ph = "i"; break;
+                }
+                // tid 255 = 태스크 밖 (커널/유휴)
+                traceEvents.add(String.format(
+                    "{\"name\":\"%s\",\"ph\":\"%s\",\"ts\":%d,\"pid\":0,\"tid\":%d,\"s\":\"t\",\"args\":{\"arg\":%d}}",
+                    name, ph, ts, task, evArg));
+            }
+
+            try (FileOutputStream out = new FileOutputStream(traceJsonPath)) {
+                StringBuilder sb = new StringBuilder("{\"traceEvents\":[\n");
+                for (int i = 0; i < traceEvents.size(); i++) {
+                    sb.append(traceEvents.get(i));
+                    sb.append(i + 1 < traceEvents.size() ? ",\n" : "\n");
+                }
+                sb.append("]}\n");
+                out.write(sb.toString().getBytes(StandardCharsets.UTF_8));
+                System.out.println("Trace: +" + n + " events (lost " + lost + "), " + traceEvents.size() + " total -> " + traceJsonPath);
+            } catch (IOException e) {
+                System.err.println("Failed to save trace: " + e.getMessage());
+            }
+        }
+    }
+
+    // 통계 스냅샷 (Stats.cpp 형식) -> 직전 스냅샷과의 차이로 초당 비율 출력
+    private static void renderTop(byte[] data) {
+        ByteBuffer b = ByteBuffer.wrap(data).order(ByteOrder.LITTLE_ENDIAN);
+        if (data.length < 34 || b.get() != 1) return;
+        int taskCount = b.get() & 0xFF;
+        long uptime = b.getInt() & 0xFFFFFFFFL;
+        long[] global = new long[9];
+        global[0] = uptime;
+        for (int i = 1; i <= 6; i++) global[i] = b.getInt() & 0xFFFFFFFFL; // sd_r, sd_w, pkt_rx, pkt_tx, b_rx, b_tx
+        global[7] = b.getShort() & 0xFFFF; // crc errors
+        global[8] = b.getShort() & 0xFFFF; // dropped
+
+        double dt = (topPrevGlobal != null && uptime > topPrevGlobal[0]) ? (uptime - topPrevGlobal[0]) / 1000.0 : 0;
+        StringBuilder sb = new StringBuilder();
+        sb.append(String.format("%n--- ArduOS top  uptime %.1fs ---%n", uptime / 1000.0));
+        if (dt > 0) {
+            sb.append(String.format("SD rd/wr %6.1f/%6.1f sect/s | RX %5.1f pkt/s %7.1f B/s | TX %5.1f pkt/s %7.1f B/s%n",
+                (global[1] - topPrevGlobal[1]) / dt, (global[2] - topPrevGlobal[2]) / dt,
+                (global[3] - topPrevGlobal[3]) / dt, (global[5] - topPrevGlobal[5]) / dt,
+                (global[4] - topPrevGlobal[4]) / dt, (global[6] - topPrevGlobal[6]) / dt));
+        }
+        sb.append(String.format("SD sectors rd %d wr %d | pkts rx %d tx %d | CRC errors %d | dropped %d%n",
+            global[1], global[2], global[3], global[4], global[7], global[8]));
+        sb.append(String.format("%-3s %-12s %-6s %10s %10s %7s %7s %7s %6s %6s %5s %3s%n",
+            "ID", "NAME", "STATE", "INSTR/s", "TURNS/s", "SLEEP%", "WAIT%", "BLOCK%", "REFILL", "SEEK", "HEAP", "AL"));
+
+        long[][] cur = new long[taskCount][];
+        for (int i = 0; i < taskCount && b.remaining() >= 42; i++) {
+            int id = b.get() & 0xFF;
+            int state = b.get();
+            b.get(); // isa
+            int allocs = b.get() & 0xFF;
+            long[] v = new long[8];
+            for (int k = 0; k < 5; k++) v[k] = b.getInt() & 0xFFFFFFFFL; // instr, turns, sleep, wait, blocked
+            v[5] = b.getShort() & 0xFFFF; // refills
+            v[6] = b.getShort() & 0xFFFF; // seeks
+            v[7] = b.getShort() & 0xFFFF; // heap cells
+            byte[] nameBytes = new byte[12];
+            b.get(nameBytes);
+            String name = new String(nameBytes, StandardCharsets.UTF_8).replace("\0", "");
+            cur[i] = v;
+
+            String stateStr = (state == -3) ? "BLOCK" : (state == -2) ? "FREE" : (state == -1) ? "RUN" : ("WAIT" + state);
+            if (state == -2) continue;
+
+            long[] prev = (topPrevTasks != null && i < topPrevTasks.length) ? topPrevTasks[i] : null;
+            if (dt > 0 && prev != null && v[0] >= prev[0]) {
+                double ms = dt * 1000.0;
+                sb.append(String.format("%-3d %-12s %-6s %10.0f %10.0f %6.1f%% %6.1f%% %6.1f%% %6d %6d %5d %3d%n",
+                    id, name, stateStr, (v[0] - prev[0]) / dt, (v[1] - prev[1]) / dt,
+                    (v[2] - prev[2]) * 100.0 / ms, (v[3] - prev[3]) * 100.0 / ms, (v[4] - prev[4]) * 100.0 / ms,
+                    v[5], v[6], v[7], allocs));
+            } else {
+                sb.append(String.format("%-3d %-12s %-6s %10s %10s %7s %7s %7s %6d %6d %5d %3d%n",
+                    id, name, stateStr, "-", "-", "-", "-", "-", v[5], v[6], v[7], allocs));
+            }
+        }
+        // 스냅샷 끝: mmap 페이지 캐시 (hits, misses, writebacks)
+        if (b.remaining() >= 12) {
+            long hits = b.getInt() & 0xFFFFFFFFL;
+            long misses = b.getInt() & 0xFFFFFFFFL;
+            long writebacks = b.getInt() & 0xFFFFFFFFL;
+            long total = hits + misses;
+            sb.append(String.format("mmap pages: hits %d misses %d (hit rate %s) | write-backs %d%n",
+                hits, misses, (total > 0) ? String.format("%.1f%%", hits * 100.0 / total) : "-", writebacks));
+        }
+        // 힙 스왑 (outs, ins, out_us, in_us, max_us)
+        if (b.remaining() >= 20) {
+            long outs = b.getInt() & 0xFFFFFFFFL;
+            long ins = b.getInt() & 0xFFFFFFFFL;
+            long outUs = b.getInt() & 0xFFFFFFFFL;
+            long inUs = b.getInt() & 0xFFFFFFFFL;
+            long maxUs = b.getInt() & 0xFFFFFFFFL;
+            sb.append(String.format("swap: out %d (avg %s) in %d (avg %s) | max %.1f ms%n",
+                outs, (outs > 0) ? String.format("%.1f ms", outUs / 1000.0 / outs) : "-",
+                ins, (ins > 0) ? String.format("%.1f ms", inUs / 1000.0 / ins) : "-", maxUs / 1000.0));
+        }
+        topPrevTasks = cur;
+        topPrevGlobal = global;
+        System.out.print(sb);
+        System.out.flush();
+    }
+
+    // 메모리 보고 (Stats.cpp Stats_sendMemInfo 형식)
+    private static void renderMemInfo(byte[] data) {
+        ByteBuffer b = ByteBuffer.wrap(data).order(ByteOrder.LITTLE_ENDIAN);
+        if (data.length < 40 || b.get() != 3) return;
+        int taskCount = b.get() & 0xFF;
+        int[] v = new int[19];
+        for (int i = 0; i < v.length; i++) v[i] = b.getShort() & 0xFFFF;
+
+        StringBuilder sb = new StringBuilder();
+        sb.append(String.format("%n--- Memory ---%n"));
+        sb.append(String.format("SRAM %d B | static %d B | C stack free now %d B, never used %d B (peak use %d B)%n",
+            v[0], v[1], v[2], v[3], v[2] - v[3]));
+        sb.append(String.format("Budget: task table %d B (%d slots) | heap %d B + bitmap %d B | HAL buf %d B | comm buf %d B | prof %d B | trace %d B%n",
+            v[5], taskCount, v[6], v[7], v[8], v[9], v[10], v[11]));
+        // static 은 링커 심볼 (__bss_end - __data_start) 로 잰 실제 값, 나머지는 위에 없는 작은 정적 표 전부
+        int listed = v[5] + v[6] + v[7] + v[8] + v[9] + v[10] + v[11];
+        sb.append(String.format("Static %d B = listed %d B + other %d B (caches, fd/pipe/mbox/shm/mmap tables, SdFat volume, ...)%n",
+            v[1], listed, v[1] - listed));
+        sb.append(String.format("Heap cells: %d used / %d (peak %d)%n", v[13], v[12], v[14]));
+        sb.append(String.format("Kernel pool (in heap): %d B used (peak %d B) | %d slots in use, TCB %d B + cold part %d B + stack each%n",
+            v[17], v[18], v[16], v[4], v[15]));
+        for (int i = 0; i < taskCount && b.remaining() >= 4; i++) {
+            int id = b.get() & 0xFF;
+            int state = b.get();
+            int hwm = b.get() & 0xFF;
+            int size = b.get() & 0xFF;
+            if (state == -2) continue;
+            sb.append(String.format("Task %d: VM stack high-water %d / %d%n", id, hwm, size));
+        }
+        System.out.print(sb);
+        System.out.flush();
+    }
+
     private static void printHelp() {
-        System.out.println("Commands: exec <file>, ls, cd <path>, pwd, ping, exit");
+        System.out.println("Commands: exec <file>, ls, cd <path>, pwd, top [ms], mem, prof start|stop|dump, trace mask|drain, ping, exit");
     }
 }
\ No newline at end of file
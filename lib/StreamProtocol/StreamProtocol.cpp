@@ -3,9 +3,8 @@
 /* 45비트 길이 필드의 최대 값 */
 #define SP_MAX_HEADER_LENGTH_VALUE 0x1FFFFFFFFFFFULL
 
-/* 내부 CRC32 구현 (Java/C++ 버전과 동일 폴리노미얼) */
-static uint32_t sp_crc32(const uint8_t* data, uint32_t length) {
-    uint32_t crc = 0xFFFFFFFFUL;
+/* CRC32 구현 (Java/C++ 버전과 동일 폴리노미얼) */
+uint32_t sp_crc32_update(uint32_t crc, const uint8_t* data, uint32_t length) {
     for (uint32_t i = 0; i < length; ++i) {
         crc ^= data[i];
         for (int j = 0; j < 8; ++j) {
@@ -13,7 +12,11 @@ static uint32_t sp_crc32(const uint8_t* data, uint32_t length) {
             crc = (crc >> 1) ^ (0xEDB88320UL & mask);
         }
     }
-    return ~crc;
+    return crc;
+}
+
+uint32_t sp_crc32(const uint8_t* data, uint32_t length) {
+    return ~sp_crc32_update(0xFFFFFFFFUL, data, length);
 }
 
 sp_result_t sp_encode_packet_buffer(const uint8_t* payload,
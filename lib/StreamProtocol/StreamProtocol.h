@@ -69,6 +69,26 @@ sp_result_t sp_parse_packet(const uint8_t* packet,
                             uint32_t packet_len,
                             sp_parsed_packet_t* out_packet);
 
+/**
+ * CRC32 (IEEE 802.3, 패킷 검증과 동일)을 계산합니다.
+ *
+ * @param data     입력 바이트
+ * @param length   입력 길이
+ * @return         최종 CRC32 값
+ */
+uint32_t sp_crc32(const uint8_t* data, uint32_t length);
+
+/**
+ * CRC32를 이어서 계산합니다. (여러 조각의 데이터를 나눠서 넣을 때 사용)
+ * 시작값은 0xFFFFFFFF, 최종 결과는 반환값을 반전(~)해서 사용합니다.
+ *
+ * @param crc      이전까지의 CRC 레지스터 값
+ * @param data     입력 바이트
+ * @param length   입력 길이
+ * @return         갱신된 CRC 레지스터 값 (반전 전)
+ */
+uint32_t sp_crc32_update(uint32_t crc, const uint8_t* data, uint32_t length);
+
 #ifdef __cplusplus
 }
 #endif
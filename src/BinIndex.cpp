@@ -0,0 +1,163 @@
+#include "BinIndex.h"
+#include "HAL.h"
+#include "Dentry.h"
+
+struct BinIndexSlot {
+  uint16_t hash;  // 0 = 빈 칸
+  uint16_t index; // /bin 디렉터리 엔트리 인덱스
+};
+
+static File32 bin_dir;
+static BinIndexSlot bin_slots[BIN_INDEX_SLOTS];
+static char bin_neg[BIN_NEG_SLOTS][BIN_NEG_NAME_LEN + 1]; // 없는 이름 (빈 문자열 = 빈 칸)
+static uint8_t bin_neg_next = 0;
+static bool bin_ready = false;
+static bool bin_full = false; // 표에 못 넣은 .bin 이 있음 (인덱스 파일에 기록)
+
+// FNV-1a (소문자 기준, FAT 이름은 대소문자 무시)
+static uint16_t BinIndex_hash(const char* s, int len) {
+  uint16_t h = 0x811C;
+  for (int i = 0; i < len && s[i]; i++) {
+    char c = s[i];
+    if (c >= 'A' && c <= 'Z') c += 'a' - 'A';
+    h = (h ^ (uint8_t)c) * 0x0193;
+  }
+  return h ? h : 1;
+}
+
+static bool BinIndex_insert(uint16_t hash, uint16_t index) {
+  for (uint8_t probe = 0; probe < BIN_INDEX_SLOTS; probe++) {
+    BinIndexSlot* s = &bin_slots[(hash + probe) & (BIN_INDEX_SLOTS - 1)];
+    if (s->hash == 0) {
+      s->hash = hash;
+      s->index = index;
+      return true;
+    }
+  }
+  return false;
+}
+
+// 인덱스 파일: ['B']['X'][ver 2][count][full][mdate u16][mtime u16] + count x [hash u16][index u16]
+static bool BinIndex_load(uint16_t mdate, uint16_t mtime) {
+  File32 f = sd.open(BIN_INDEX_PATH, FILE_READ);
+  if (!f) return false;
+
+  uint8_t head[9];
+  bool ok = f.read(head, 9) == 9 && head[0] == 'B' && head[1] == 'X' && head[2] == 2 &&
+            (head[5] | (head[6] << 8)) == mdate && (head[7] | (head[8] << 8)) == mtime;
+  for (uint8_t i = 0; ok && i < head[3]; i++) {
+    uint8_t e[4];
+    ok = f.read(e, 4) == 4 && BinIndex_insert(e[0] | (e[1] << 8), e[2] | (e[3] << 8));
+  }
+  f.close();
+  if (ok) bin_full = head[4] != 0;
+  return ok;
+}
+
+static void BinIndex_save(uint16_t mdate, uint16_t mtime, uint8_t count) {
+  File32 f = sd.open(BIN_INDEX_PATH, O_WRONLY | O_CREAT | O_TRUNC);
+  if (!f) return; // 읽기 전용 카드 등: 표는 RAM 에만 유지
+
+  uint8_t head[9] = {'B', 'X', 2, count, (uint8_t)bin_full,
+                     (uint8_t)mdate, (uint8_t)(mdate >> 8), (uint8_t)mtime, (uint8_t)(mtime >> 8)};
+  f.write(head, 9);
+  for (uint8_t i = 0; i < BIN_INDEX_SLOTS; i++) {
+    if (bin_slots[i].hash == 0) continue;
+    uint8_t e[4] = {(uint8_t)bin_slots[i].hash, (uint8_t)(bin_slots[i].hash >> 8),
+                    (uint8_t)bin_slots[i].index, (uint8_t)(bin_slots[i].index >> 8)};
+    f.write(e, 4);
+  }
+  f.close();
+}
+
+// /bin 스캔 (openNext + dirIndex)
+static uint8_t BinIndex_scan() {
+  uint8_t count = 0;
+  File32 entry;
+  bin_dir.rewind();
+  while (entry.openNext(&bin_dir, O_RDONLY)) {
+    char name[32];
+    entry.getName(name, sizeof(name));
+    int len = strlen(name);
+    if (!entry.isDir() && len > 4 && strcasecmp(name + len - 4, ".bin") == 0) {
+      if (BinIndex_insert(BinIndex_hash(name, len - 4), entry.dirIndex())) count++;
+      else bin_full = true;
+    }
+    entry.close();
+  }
+  return count;
+}
+
+// 첫 조회 시 (또는 무효화 후) 표 준비
+static bool BinIndex_prepare() {
+  if (bin_ready) return true;
+
+  memset(bin_slots, 0, sizeof(bin_slots));
+  memset(bin_neg, 0, sizeof(bin_neg));
+  bin_full = false;
+  if (bin_dir.isOpen()) bin_dir.close();
+  if (!Dentry_open("/bin", &bin_dir) || !bin_dir.isDir()) return false;
+
+  uint16_t mdate = 0, mtime = 0;
+  bin_dir.getModifyDateTime(&mdate, &mtime);
+  if (!BinIndex_load(mdate, mtime)) {
+    memset(bin_slots, 0, sizeof(bin_slots));
+    bin_full = false;
+    BinIndex_save(mdate, mtime, BinIndex_scan());
+  }
+  bin_ready = true;
+  return true;
+}
+
+bool BinIndex_open(const char* name, File32* out, char* path_out) {
+  if (!BinIndex_prepare()) return false;
+
+  int len = strlen(name);
+  uint16_t hash = BinIndex_hash(name, len);
+  char fname[32];
+  for (uint8_t probe = 0; probe < BIN_INDEX_SLOTS; probe++) {
+    BinIndexSlot* s = &bin_slots[(hash + probe) & (BIN_INDEX_SLOTS - 1)];
+    if (s->hash == 0) break; // 표에 없음
+    if (s->hash != hash) continue;
+
+    // 해시 충돌 대비: 연 뒤 이름 확인
+    if (!out->open(&bin_dir, s->index, O_RDONLY)) continue;
+    out->getName(fname, sizeof(fname));
+    if ((int)strlen(fname) == len + 4 && strncasecmp(fname, name, len) == 0) {
+      strcpy(path_out, "/bin/");
+      strcat(path_out, fname);
+      return true;
+    }
+    out->close();
+  }
+
+  // 표에 없음: 표가 넘쳤거나 만든 뒤에 들어온 파일일 수 있으므로 디렉터리를 직접 찾음
+  if (len + 4 >= (int)sizeof(fname)) return false;
+  strcpy(fname, name);
+  strcat(fname, ".bin");
+  if (!out->open(&bin_dir, fname, O_RDONLY)) return false;
+  strcpy(path_out, "/bin/");
+  strncat(path_out, fname, 31 - strlen(path_out));
+  return true;
+}
+
+// 음성 캐시는 이름 자체를 비교 (해시만 두면 충돌한 다른 명령이 없는 것으로 보임)
+bool BinIndex_isMissing(const char* name) {
+  for (uint8_t i = 0; i < BIN_NEG_SLOTS; i++) {
+    if (bin_neg[i][0] != '\0' && strcasecmp(bin_neg[i], name) == 0) return true;
+  }
+  return false;
+}
+
+void BinIndex_noteMissing(const char* name) {
+  if (strlen(name) > BIN_NEG_NAME_LEN) return; // 긴 이름은 기억하지 않음 (매번 탐색)
+  strcpy(bin_neg[bin_neg_next], name);
+  bin_neg_next = (bin_neg_next + 1) % BIN_NEG_SLOTS;
+}
+
+void BinIndex_invalidate(const char* path) {
+  memset(bin_neg, 0, sizeof(bin_neg)); // 루트의 name.bin 도 음성 캐시에 들어 있을 수 있음
+  if (path != NULL && !(strncasecmp(path, "/bin", 4) == 0 && (path[4] == '/' || path[4] == '\0'))) return;
+  bin_ready = false;
+  sd.remove(BIN_INDEX_PATH); // 낡은 표가 재부팅 뒤 다시 읽히지 않도록
+}
@@ -0,0 +1,33 @@
+#ifndef BIN_INDEX_H
+#define BIN_INDEX_H
+
+#include "OSConfig.h"
+#include <SdFat.h>
+
+// -----------------------------------------------------------------
+// [/bin Lookup Index]
+// "/bin/<name>.bin" 실행 파일을 이름 해시 -> 디렉터리 인덱스 표로 찾습니다.
+// 해시 한 번 + FatFile::open(dir, index) 로 열리므로 디렉터리 스캔이 없습니다.
+//
+// - 표는 처음 쓸 때 /bin.idx 에서 읽고, /bin 의 수정 시각이 다르면 다시 스캔해 저장합니다.
+//   (호스트에서 파일을 넣으면 /bin 수정 시각이 바뀜 / 카드는 전원이 꺼진 상태에서만 교체)
+// - 표에 없는 이름은 /bin 을 직접 찾습니다 (표가 낡았거나 넘쳤어도 새 파일을 놓치지 않음).
+// - 없는 명령은 이름째 음성 캐시에 남겨 다음 조회에서 SD 접근 없이 실패합니다.
+// - 커널이 파일을 만들거나 지우면 BinIndex_invalidate(path) 를 불러야 합니다.
+//   /bin 아래 경로면 /bin.idx 도 지워 (SdFat 은 디렉터리 수정 시각을 갱신하지 않음) 다음 조회에서 다시 스캔합니다.
+// -----------------------------------------------------------------
+
+#define BIN_INDEX_PATH "/bin.idx"
+#define BIN_NEG_NAME_LEN 12 // 음성 캐시에 남길 수 있는 이름 길이
+
+// name(확장자 없는 명령 이름)을 /bin 에서 찾아 out 으로 엶. 경로는 path_out(32)에 기록
+bool BinIndex_open(const char* name, File32* out, char* path_out);
+
+// [음성 캐시] 전체 탐색(PATH)에 실패한 명령 이름
+bool BinIndex_isMissing(const char* name);
+void BinIndex_noteMissing(const char* name);
+
+// 음성 캐시 비움 + (path 가 /bin 아래이거나 NULL 이면) 표와 /bin.idx 를 버림
+void BinIndex_invalidate(const char* path);
+
+#endif
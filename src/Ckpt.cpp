@@ -0,0 +1,238 @@
+#include "Ckpt.h"
+#include "Kernel.h"
+#include "HAL.h"
+#include "Swap.h"
+#include "Dentry.h"
+
+#define CKPT_MAGIC   0xCE
+#define CKPT_VERSION 1
+#define CKPT_NEW_SUFFIX ".new" // 쓰는 중인 새 체크포인트 (다 쓰고 sync 한 뒤 원래 이름으로 바꿈)
+
+// 같은 보드에서만 읽으므로 구조체를 그대로 씀 (int = 2 bytes, LE)
+struct CkptHeader {
+  uint8_t magic;
+  uint8_t version;
+  uint8_t isa;
+  uint8_t stack_size;
+  int sp;
+  uint8_t stack_hwm;
+  uint8_t name_len;
+  uint8_t cwd_len;
+  uint8_t args_len;
+  uint16_t pc;          // 다음에 실행할 코드 오프셋
+  uint32_t wake_in;     // 남은 잠 시간 (ms, 0 = 깨어 있음)
+  int heap_limit;
+  int regs[VM_REG_COUNT];
+  struct {
+    int ptr;
+    int size;
+  } allocs[MAX_ALLOCATIONS];
+};
+
+static bool Ckpt_writeString(File32* f, const char* s, uint8_t len) {
+  return f->write(s, len) == len;
+}
+
+// path + CKPT_NEW_SUFFIX (out 은 64 bytes, 넘치면 false)
+static bool Ckpt_newPath(const char* path, char* out) {
+  if (strlen(path) + sizeof(CKPT_NEW_SUFFIX) > 64) return false;
+  strcpy(out, path);
+  strcat(out, CKPT_NEW_SUFFIX);
+  return true;
+}
+
+bool Ckpt_save(Task* t, const char* path) {
+  if (t->cold == NULL || !t->isActive()) return false;
+  if (t->isSwapped() && !Swap_in(t)) return false;
+
+  CkptHeader h;
+  memset(&h, 0, sizeof(h));
+  h.magic = CKPT_MAGIC;
+  h.version = CKPT_VERSION;
+  h.isa = t->isa;
+  h.stack_size = t->stack_size;
+  h.sp = t->sp;
+  h.stack_hwm = t->stack_hwm;
+  h.name_len = strlen(t->filename);
+  h.cwd_len = strlen(t->cwd);
+  h.args_len = strlen(t->args);
+  h.pc = t->codePc();
+  h.wake_in = (t->wake_up_time > system_ticks) ? t->wake_up_time - system_ticks : 0;
+  h.heap_limit = t->heap_limit;
+  memcpy(h.regs, t->regs, sizeof(h.regs));
+  for (int i = 0; i < MAX_ALLOCATIONS; i++) {
+    h.allocs[i].ptr = t->alloc_table[i].ptr;
+    h.allocs[i].size = t->alloc_table[i].size;
+  }
+
+  // 옛 체크포인트는 새 파일을 다 쓰기 전까지 그대로 둠 (쓰는 중 전원이 나가도 하나는 온전함)
+  char new_path[64];
+  File32 f;
+  if (!Ckpt_newPath(path, new_path) || !Kernel_openFile(new_path, O_WRONLY | O_CREAT | O_TRUNC, &f)) return false;
+  bool ok = f.write(&h, sizeof(h)) == sizeof(h) &&
+            Ckpt_writeString(&f, t->filename, h.name_len) &&
+            Ckpt_writeString(&f, t->cwd, h.cwd_len) &&
+            Ckpt_writeString(&f, t->args, h.args_len);
+
+  uint16_t bytes = (t->sp + 1) * sizeof(int);
+  if (ok) ok = f.write(t->stack, bytes) == bytes;
+  bytes = t->heap_limit * sizeof(int);
+  if (ok) ok = f.write(&global_heap[t->heap_base], bytes) == bytes;
+  for (int i = 0; ok && i < MAX_ALLOCATIONS; i++) {
+    if (h.allocs[i].ptr == -1) continue;
+    bytes = h.allocs[i].size * sizeof(int);
+    ok = f.write(&global_heap[h.allocs[i].ptr], bytes) == bytes;
+  }
+  ok = f.sync() && ok;
+  ok = f.close() && ok;
+  if (!ok) {
+    sd.remove(new_path);
+    Kernel_onFsWrite(new_path);
+    return false;
+  }
+
+  // 교체: 옛 파일을 지우고 새 파일 이름을 바꿈
+  // (그 사이에 전원이 나가면 새 파일만 남으며 Ckpt_resume 이 그것을 읽음)
+  sd.remove(path);
+  ok = sd.rename(new_path, path);
+  Kernel_onFsWrite(path);
+  return ok;
+}
+
+static bool Ckpt_readString(File32* f, char* out, uint8_t len, uint8_t cap) {
+  if (len >= cap || f->read(out, len) != len) return false;
+  out[len] = '\0';
+  return true;
+}
+
+// 블록 칸을 원래 주소에 다시 잡음 (한 칸이라도 차 있으면 잡은 것을 되돌리고 false)
+static bool Ckpt_claimBlocks(const CkptHeader* h) {
+  for (int i = 0; i < MAX_ALLOCATIONS; i++) {
+    if (h->allocs[i].ptr == -1) continue;
+    if (!Kernel_claimCells(h->allocs[i].ptr, h->allocs[i].size)) {
+      while (--i >= 0) {
+        if (h->allocs[i].ptr != -1) Kernel_freeCells(h->allocs[i].ptr, h->allocs[i].size);
+      }
+      return false;
+    }
+  }
+  return true;
+}
+
+static void Ckpt_releaseBlocks(Task* t) {
+  for (int i = 0; i < MAX_ALLOCATIONS; i++) {
+    if (t->alloc_table[i].ptr != -1) Kernel_free(t, t->alloc_table[i].ptr);
+  }
+}
+
+int Ckpt_resume(const char* path, int8_t parent) {
+  int id = -1;
+  for (int i = 1; i < TASK_COUNT; i++) {
+    if (tasks[i]->task_state == TASK_FREE) { id = i; break; }
+  }
+  if (id == -1) {
+    HAL_write(FD_STDERR, "Error: No free task slots.\n");
+    return -1;
+  }
+
+  File32 f;
+  CkptHeader h;
+  char name[32], cwd[64], args[64];
+  if (!Kernel_openFile(path, O_RDONLY, &f)) {
+    // 교체 도중 전원이 나갔으면 다 쓴 새 파일이 .new 이름으로 남아 있음
+    char new_path[64];
+    if (!Ckpt_newPath(path, new_path) || !Kernel_openFile(new_path, O_RDONLY, &f)) return -1;
+  }
+  bool ok = f.read(&h, sizeof(h)) == sizeof(h) &&
+            h.magic == CKPT_MAGIC && h.version == CKPT_VERSION &&
+            Ckpt_readString(&f, name, h.name_len, sizeof(name)) &&
+            Ckpt_readString(&f, cwd, h.cwd_len, sizeof(cwd)) &&
+            Ckpt_readString(&f, args, h.args_len, sizeof(args));
+  if (!ok) {
+    HAL_write(FD_STDERR, "Error: bad checkpoint\n");
+    f.close();
+    return -1;
+  }
+
+  // 블록을 먼저 원래 주소에 잡고 (TCB/세그먼트가 그 자리를 차지하지 않도록) 슬롯에 넘긴 뒤 실행 파일 로드
+  if (!Ckpt_claimBlocks(&h)) {
+    HAL_write(FD_STDERR, "Error: checkpoint blocks in use\n");
+    f.close();
+    return -1;
+  }
+  Task* t = Kernel_claimSlot(id);
+  if (t == NULL) {
+    for (int i = 0; i < MAX_ALLOCATIONS; i++) {
+      if (h.allocs[i].ptr != -1) Kernel_freeCells(h.allocs[i].ptr, h.allocs[i].size);
+    }
+    f.close();
+    return -1;
+  }
+  for (int i = 0; i < MAX_ALLOCATIONS; i++) {
+    t->alloc_table[i].ptr = h.allocs[i].ptr;
+    t->alloc_table[i].size = h.allocs[i].size;
+  }
+  if (!Kernel_loadTask(id, name, NULL, cwd, args)) {
+    Ckpt_releaseBlocks(t);
+    Kernel_dropSlot(id);
+    f.close();
+    return -1;
+  }
+
+  // 실행 파일이 바뀌어 크기가 다르면 되살릴 수 없음
+  ok = t->isa == h.isa && t->stack_size == h.stack_size && t->heap_limit == h.heap_limit &&
+       h.sp >= -1 && h.sp < h.stack_size && h.pc <= t->code_size;
+  uint16_t bytes = (h.sp + 1) * sizeof(int);
+  if (ok) ok = f.read(t->stack, bytes) == bytes;
+  bytes = h.heap_limit * sizeof(int);
+  if (ok) ok = f.read(&global_heap[t->heap_base], bytes) == bytes;
+  for (int i = 0; ok && i < MAX_ALLOCATIONS; i++) {
+    if (h.allocs[i].ptr == -1) continue;
+    bytes = h.allocs[i].size * sizeof(int);
+    ok = f.read(&global_heap[h.allocs[i].ptr], bytes) == bytes;
+  }
+  f.close();
+  if (!ok) {
+    HAL_write(FD_STDERR, "Error: checkpoint does not match executable\n");
+    Kernel_terminateTask(id); // 잡아 둔 블록도 함께 반납
+    return -1;
+  }
+
+  t->sp = h.sp;
+  t->stack_hwm = h.stack_hwm;
+  memcpy(t->regs, h.regs, sizeof(t->regs));
+  if (h.wake_in != 0) {
+    t->wake_up_time = system_ticks + h.wake_in;
+    t->stats.state_since = system_ticks;
+  }
+  t->parent = parent;
+  Kernel_jump(t, h.pc);
+  return id;
+}
+
+void Ckpt_resumeAll() {
+  File32 dir;
+  if (!Dentry_open(CKPT_DIR, &dir) || !dir.isDir()) return;
+
+  File32 entry;
+  char name[32];
+  char path[64];
+  const int suffix_len = sizeof(CKPT_NEW_SUFFIX) - 1;
+  while (entry.openNext(&dir, O_RDONLY)) {
+    bool is_file = !entry.isDir();
+    entry.getName(name, sizeof(name));
+    entry.close();
+    if (!is_file) continue;
+    // 쓰다 만 .new 는 건너뜀: 원래 이름이 없을 때만 (교체 도중 전원 끊김) 원래 이름으로 재개
+    int len = strlen(name);
+    bool is_new = len > suffix_len && strcmp(name + len - suffix_len, CKPT_NEW_SUFFIX) == 0;
+    if (is_new) name[len - suffix_len] = '\0';
+    strcpy(path, CKPT_DIR "/");
+    strncat(path, name, sizeof(path) - 1 - strlen(path));
+    if (is_new && sd.exists(path)) continue;
+    HAL_write(FD_STDOUT, "Resume ");
+    HAL_write(FD_STDOUT, path);
+    HAL_write(FD_STDOUT, (Ckpt_resume(path, 0) != -1) ? " ok\n" : " failed\n");
+  }
+  dir.close();
+}
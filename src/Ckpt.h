@@ -0,0 +1,23 @@
+#ifndef CKPT_H
+#define CKPT_H
+
+#include "Task.h"
+
+// -----------------------------------------------------------------
+// [체크포인트]
+// 태스크의 실행 상태를 SD 파일 하나에 순서대로 씁니다.
+//   헤더 (ISA, sp, PC, 남은 잠 시간, 레지스터, 힙 크기, MALLOC 블록 표)
+//   -> 실행 파일 경로 / cwd / args -> 스택 -> 기본 세그먼트 -> MALLOC 블록 내용
+// 되살릴 때는 실행 파일을 다시 로드하고 (힙 세그먼트는 새 자리, heap_base 가 바뀔 수 있음)
+// 파일을 한 번 차례로 읽어 상태를 덮어쓴 뒤 PC 로 점프합니다.
+// MALLOC 블록은 절대 주소로 쓰이므로 같은 주소에 다시 잡아야 하며, 자리가 차 있으면 실패합니다.
+// 열린 fd, 파이프, 메일박스, 공유 세그먼트, 파일 매핑은 담지 않습니다 (재개 시 표준 입출력만).
+// 저장은 "<path>.new" 에 다 쓰고 sync 한 뒤 옛 파일을 지우고 이름을 바꿉니다.
+// 어느 순간 전원이 나가도 온전한 체크포인트 하나가 남습니다 (원래 이름이 없으면 .new 에서 재개).
+// -----------------------------------------------------------------
+
+bool Ckpt_save(Task* t, const char* path);       // 상태 저장 (스왑된 세그먼트는 먼저 읽어 옴)
+int  Ckpt_resume(const char* path, int8_t parent); // 빈 슬롯에 재개: 태스크 ID, 실패 시 -1
+void Ckpt_resumeAll();                           // CKPT_DIR 의 모든 체크포인트 재개 (부팅)
+
+#endif
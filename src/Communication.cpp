@@ -2,6 +2,14 @@
 #include "Protocol.h"
 #include <StreamProtocol.h>
 #include "HAL.h" // Serial 사용
+#include "Profiler.h"
+#include "Trace.h"
+#include "Stats.h"
+#include "Dentry.h"
+#include "KFile.h"
+#include "Pipe.h"
+#include "Tmpfs.h"
+#include "Rom.h"
 
 // --- 버퍼 정의 ---
 #define RX_BUFFER_SIZE 256
@@ -10,6 +18,10 @@ static uint32_t rx_index = 0;
 
 // (Tx 버퍼는 필요할 때 생성하거나 여기서 관리)
 
+uint16_t Comm_bufferBytes() {
+    return sizeof(rx_buffer);
+}
+
 void Comm_init() {
     memset(rx_buffer, 0, RX_BUFFER_SIZE);
     rx_index = 0;
@@ -43,27 +55,186 @@ int Comm_copyToHeap(Task* t, const uint8_t* data, uint32_t len) {
     return 1; // 가상 주소 1번지 리턴
 }
 
-// [후처리 헬퍼] 힙에서 문자열 읽어서 전송
-void Comm_sendHeapString(Task* t, int offset, int max_len) {
+// -----------------------------------------------------------------
+// [ls 스트리밍 커서]
+// 태스크 0 이 빌린 커널 파일 핸들 하나로 디렉터리를 조금씩 읽어 CMD_LIST 조각으로 보냅니다.
+// 조각은 LS_CHUNK_BYTES 이하이며 항목이 조각 경계에서 잘리지 않습니다.
+// 흐름 제어: ack 없이 LS_WINDOW 조각까지만 먼저 보내고, PC 가 조각마다 CMD_LIST 로 ack.
+// LS_ACK_TIMEOUT_MS 동안 ack 가 없으면 (PC 가 끊겼거나 응답을 버림) 나열을 버리고 핸들을 반납합니다.
+// 스케줄러 한 바퀴에 최대 한 조각이므로 큰 디렉터리도 다른 태스크를 오래 막지 않습니다.
+// -----------------------------------------------------------------
+#define LS_ROM 127  // list_handle: /rom 목록 (커서는 list_rom)
+
+static int8_t  list_handle = KFILE_NONE;
+static uint8_t list_credit = 0;
+static int8_t  list_rom;
+static unsigned long list_ack_at; // 마지막으로 조각을 보냈거나 ack 를 받은 시각 (ms)
+
+// 커서 핸들 반납
+static void Comm_listClose() {
+    if (Tmpfs_isEnd(list_handle)) Tmpfs_close(list_handle);
+    else if (list_handle != KFILE_NONE && list_handle != LS_ROM) KFile_free(list_handle);
+    list_handle = KFILE_NONE;
+}
+
+static void Comm_listStart(Task* t, const char* path) {
+    Comm_listClose(); // 진행 중인 나열은 취소
+    list_ack_at = system_ticks;
+
+    if (Rom_isPath(path)) { // 플래시 이미지 목록
+        list_handle = LS_ROM;
+        list_rom = 0;
+        list_credit = LS_WINDOW;
+        return;
+    }
+    if (Tmpfs_isPath(path)) { // RAM 디스크: tmpfs 디렉터리 커서
+        list_handle = Tmpfs_opendir(t->id, path);
+        if (list_handle == -1) {
+            list_handle = KFILE_NONE;
+            HAL_write(FD_STDERR, "Error: ls failed (Invalid directory)\n");
+            return;
+        }
+        list_credit = LS_WINDOW;
+        return;
+    }
+
+    list_handle = KFile_alloc(t->id);
+    File32* dir = KFile_get(list_handle, t->id);
+    if (dir == NULL || !Dentry_open(path, dir) || !dir->isDir()) {
+        KFile_free(list_handle);
+        list_handle = KFILE_NONE;
+        HAL_write(FD_STDERR, "Error: ls failed (Invalid directory)\n");
+        return;
+    }
+    list_credit = LS_WINDOW;
+}
+
+static void Comm_listStep(Task* t) {
+    if (list_handle == KFILE_NONE) return;
+    if (list_credit == 0) {
+        if (system_ticks - list_ack_at > LS_ACK_TIMEOUT_MS) Comm_listClose(); // ack 가 오지 않음
+        return;
+    }
+    bool rom = (list_handle == LS_ROM);
+    bool tmp = Tmpfs_isEnd(list_handle);
+    File32* dir = (tmp || rom) ? NULL : KFile_get(list_handle, t->id);
+
+    char chunk[LS_CHUNK_BYTES];
+    uint16_t len = 0;
+    bool done = false;
+
+    for (;;) {
+        uint32_t pos = rom ? list_rom : tmp ? Tmpfs_tell(list_handle) : dir->curPosition();
+        char name[32];
+        memset(name, 0, sizeof(name));
+        bool is_dir = false;
+        if (rom) {
+            RomEntry e;
+            if (!Rom_entry(list_rom, &e)) { done = true; break; }
+            strncpy(name, e.name, sizeof(name) - 1);
+            list_rom++;
+        } else if (tmp) {
+            uint16_t size;
+            if (Tmpfs_readdir(list_handle, name, sizeof(name) - 1, &size) != 1) { done = true; break; }
+        } else {
+            File32 entry;
+            if (!entry.openNext(dir, O_RDONLY)) { done = true; break; }
+            entry.getName(name, sizeof(name) - 1); // '/' 붙일 자리 남김
+            is_dir = entry.isDir();
+            entry.close();
+        }
+
+        uint16_t n = strlen(name);
+        if (is_dir) name[n++] = '/';
+
+        // 이 조각에 안 들어가면 되감고 다음 조각에서 다시 읽음 (빈 조각에는 항상 들어감)
+        if (len + n + 1 > LS_CHUNK_BYTES) {
+            if (rom) list_rom = pos;
+            else if (tmp) Tmpfs_seek(list_handle, pos);
+            else dir->seekSet(pos);
+            break;
+        }
+        memcpy(chunk + len, name, n);
+        len += n;
+        chunk[len++] = '\n';
+    }
+
+    if (len > 0) {
+        HAL_sendPacket(CMD_LIST, PT_STRING, (const uint8_t*)chunk, len);
+        list_credit--;
+        list_ack_at = system_ticks;
+    }
+    if (done) {
+        HAL_sendPacket(CMD_LIST, PT_NONE, NULL, 0); // 빈 조각 = 끝 (ack 불필요)
+        Comm_listClose();
+    }
+}
+
+// --- 헬퍼: 바이트열(+접미사)을 힙 [offset] 에 문자열로 기록 ---
+static void Comm_putHeapString(Task* t, int offset, const uint8_t* data, int len, const char* suffix, int max_len) {
     if (t->heap_base == -1) return;
-    
     int phys_base = t->heap_base + offset;
-    char buf[128]; // 임시 버퍼 (스택)
+    int n = 0;
+    for (int i = 0; i < len && n < max_len; i++) global_heap[phys_base + n++] = data[i];
+    for (int i = 0; suffix[i] != 0 && n < max_len; i++) global_heap[phys_base + n++] = suffix[i];
+    global_heap[phys_base + n] = 0;
+}
+
+// --- exec 대리 호출 ---
+// line = "cmd [args]" : cmd 는 Heap 1, args(+suffix: 리다이렉트 등)는 Heap 64 에 두고 SYS_EXEC 호출
+static void Comm_exec(Task* t, int wait_opt, const uint8_t* line, int len, const char* suffix) {
     int i = 0;
-    
-    // int 힙 -> char 변환
-    while (i < max_len && i < 127) { // 127 to leave room for NULL
-        if (phys_base + i >= GLOBAL_HEAP_SIZE) break;
-        int val = global_heap[phys_base + i];
-        if (val == 0) break; // NULL 종료
-        buf[i] = (char)val;
-        i++;
+    while (i < len && line[i] == ' ') i++;
+    int cmd_start = i;
+    while (i < len && line[i] != ' ') i++;
+    int cmd_len = i - cmd_start;
+    while (i < len && line[i] == ' ') i++;
+    int arg_len = len - i;
+    while (arg_len > 0 && line[i + arg_len - 1] == ' ') arg_len--;
+
+    Comm_putHeapString(t, 1, line + cmd_start, cmd_len, "", 62);
+    int arg_addr = 0;
+    if (arg_len > 0 || suffix[0] != 0) {
+        Comm_putHeapString(t, 64, line + i, arg_len, suffix, 63);
+        arg_addr = 64;
     }
-    buf[i] = '\0';
-    
-    if (i > 0) {
-        HAL_write(FD_STDOUT, buf);
+
+    t->sp = -1;
+    t->stack[++t->sp] = arg_addr;
+    t->stack[++t->sp] = 1;        // CmdAddr (Heap 1)
+    t->stack[++t->sp] = wait_opt;
+    Kernel_systemCall(t, SYS_EXEC);
+    HAL_write(FD_STDOUT, "Exec started.\n");
+}
+
+// --- 파이프라인 "a args | b args" ---
+// 데몬 fd 표에 파이프를 잠깐 열고 a 는 ">&w" (Async), b 는 "<&r" (wait_opt) 로 실행한 뒤 데몬 쪽 끝은 닫음
+static void Comm_execPipeline(Task* t, int wait_opt, const uint8_t* line, int bar, int len) {
+    int fd_r = -1, fd_w = -1;
+    for (int i = FD_STDERR + 1; i < TASK_FDS; i++) {
+        if (t->fds[i] != KFILE_NONE) continue;
+        if (fd_r == -1) fd_r = i;
+        else if (fd_w == -1) fd_w = i;
+    }
+    int8_t r, w;
+    if (fd_w == -1 || Pipe_create(&r, &w) == -1) {
+        HAL_write(FD_STDERR, "Error: No free pipe.\n");
+        return;
     }
+    t->fds[fd_r] = r;
+    t->fds[fd_w] = w;
+
+    char suffix[] = " >&0";
+    suffix[3] = '0' + fd_w;
+    Comm_exec(t, 0, line, bar, suffix); // 왼쪽은 오른쪽과 함께 돌아야 하므로 항상 Async
+    suffix[1] = '<';
+    suffix[3] = '0' + fd_r;
+    Comm_exec(t, wait_opt, line + bar + 1, len - bar - 1, suffix);
+
+    Pipe_unref(r);
+    Pipe_unref(w);
+    t->fds[fd_r] = KFILE_NONE;
+    t->fds[fd_w] = KFILE_NONE;
 }
 
 void Comm_process(Task* t) {
@@ -91,113 +262,38 @@ void Comm_process(Task* t) {
           t->sp = -1;
 
           if (cmd_id == SYS_LS) {
-                  // [수정] 스택 Push 순서 변경 (Syscall_ls의 Pop 순서에 맞춤)
-                  // Syscall_ls Pop 순서: Addr -> Size -> Selector
-                  // 따라서 Push 순서: Selector -> Size -> Addr (LIFO)
-                  
-                  int selector = 0;
-                  // [수정] 인자(Path) 처리
+                  // 힙 버퍼에 담지 않고 커서로 스트리밍 (Comm_listStep)
+                  char target_path[64];
                   if (payload_len > 0) {
-                      // Payload를 t->args에 복사 (최대 31자)
+                      // Payload = 경로 (최대 31자, 상대 경로면 CWD 기준)
+                      char path[32];
                       uint32_t len = payload_len;
                       if (len > 31) len = 31;
-                      
-                      // memcpy 대신 루프 사용
-                      for(uint32_t i=0; i<len; i++) t->args[i] = rx_buffer[i];
-                      t->args[len] = 0; // NULL Terminate
-                      
-                      selector = 1;   // TargetSelector (1=Args)
+                      for(uint32_t i=0; i<len; i++) path[i] = rx_buffer[i];
+                      path[len] = 0; // NULL Terminate
+                      resolve_path(t, path, target_path);
                   } else {
-                      selector = 0;   // TargetSelector (0=CWD)
-                  }
-
-                  t->stack[++t->sp] = 0;        // Buffer Addr (먼저 Push -> 나중에 Pop)
-                  t->stack[++t->sp] = 128;      // Buffer Size
-                  t->stack[++t->sp] = selector; // Selector (나중에 Push -> 먼저 Pop)
-                  
-                  Kernel_systemCall(t, SYS_LS);
-                  
-                  // [수정] 결과 확인 (에러 코드 -1 체크)
-                  if (t->heap_base != -1 && global_heap[t->heap_base + 0] == -1) {
-                      HAL_write(FD_STDERR, "Error: ls failed (Invalid directory)\n");
-                  } else {
-                      // [후처리] 결과 전송
-                      Comm_sendHeapString(t, 0, 128);
+                      strcpy(target_path, t->cwd);
                   }
+                  Comm_listStart(t, target_path);
 
           } else if (cmd_id == SYS_EXEC) {
+                  // 형식: "W cmd [args] [| cmd [args]]" (W: 1=Sync, 0=Async / 없으면 Async)
                   int wait_opt = 0;
-                  int cmd_addr = 1; // Heap 1
-                  int arg_addr = 0; // NULL
-                  
-                  // 1. 첫 번째 공백 찾기 (WaitOption 구분)
-                  int first_space = -1;
-                  for(int i=0; i<payload_len; i++) {
-                      if (rx_buffer[i] == ' ') {
-                          first_space = i;
-                          break;
-                      }
-                  }
-                  
-                  if (first_space != -1) {
-                      // WaitOption 파싱
-                      if (rx_buffer[0] == '1') wait_opt = 1;
-                      else wait_opt = 0;
-                      
-                      // 2. 두 번째 공백 찾기
-                      int second_space = -1;
-                      for(int i=first_space+1; i<payload_len; i++) {
-                          if (rx_buffer[i] == ' ') {
-                              second_space = i;
-                              break;
-                          }
-                      }
-                      
-                      if (second_space == -1) {
-                          // Arg 없음
-                          int cmd_len = payload_len - (first_space + 1);
-                          if (cmd_len > 0 && t->heap_base != -1) {
-                              int phys_base = t->heap_base + 1;
-                              for(int i=0; i<cmd_len; i++) {
-                                  if (phys_base + i >= GLOBAL_HEAP_SIZE) break;
-                                  global_heap[phys_base + i] = rx_buffer[first_space + 1 + i];
-                              }
-                              if (phys_base + cmd_len < GLOBAL_HEAP_SIZE) global_heap[phys_base + cmd_len] = 0;
-                          }
-                      } else {
-                          // Arg 있음
-                          int cmd_len = second_space - (first_space + 1);
-                          if (cmd_len > 0 && t->heap_base != -1) {
-                              int phys_base = t->heap_base + 1;
-                              for(int i=0; i<cmd_len; i++) {
-                                  if (phys_base + i >= GLOBAL_HEAP_SIZE) break;
-                                  global_heap[phys_base + i] = rx_buffer[first_space + 1 + i];
-                              }
-                              if (phys_base + cmd_len < GLOBAL_HEAP_SIZE) global_heap[phys_base + cmd_len] = 0;
-                          }
-                          
-                          int arg_len = payload_len - (second_space + 1);
-                          if (arg_len > 0 && t->heap_base != -1) {
-                              int phys_base = t->heap_base + 64; // Heap 64
-                              for(int i=0; i<arg_len; i++) {
-                                  if (phys_base + i >= GLOBAL_HEAP_SIZE) break;
-                                  global_heap[phys_base + i] = rx_buffer[second_space + 1 + i];
-                              }
-                              if (phys_base + arg_len < GLOBAL_HEAP_SIZE) global_heap[phys_base + arg_len] = 0;
-                              arg_addr = 64;
-                          }
-                      }
-                  } else {
-                      // 공백 없음 (형식 오류) -> Fallback
-                      Comm_copyToHeap(t, rx_buffer, payload_len);
+                  int start = 0;
+                  if (payload_len >= 2 && (rx_buffer[0] == '0' || rx_buffer[0] == '1') && rx_buffer[1] == ' ') {
+                      wait_opt = (rx_buffer[0] == '1') ? 1 : 0;
+                      start = 2;
                   }
+                  const uint8_t* line = rx_buffer + start;
+                  int len = payload_len - start;
 
-                  t->stack[++t->sp] = arg_addr; 
-                  t->stack[++t->sp] = cmd_addr; 
-                  t->stack[++t->sp] = wait_opt; 
-                  
-                  Kernel_systemCall(t, SYS_EXEC);
-                  HAL_write(FD_STDOUT, "Exec started.\n");
+                  int bar = -1;
+                  for (int i = 0; i < len; i++) {
+                      if (line[i] == '|') { bar = i; break; }
+                  }
+                  if (bar == -1) Comm_exec(t, wait_opt, line, len, "");
+                  else Comm_execPipeline(t, wait_opt, line, bar, len);
 
           } else if (cmd_id == SYS_CHDIR) {
                   t->stack[++t->sp] = 64; // Buffer Addr (Result)
@@ -227,5 +323,25 @@ void Comm_process(Task* t) {
                   // Unknown SysCall ID
           }
       }
+      // [B] 특수 명령 처리
+      else if (cmd_id == CMD_PROF) {
+          Profiler_command(rx_buffer, payload_len);
+      }
+      else if (cmd_id == CMD_TRACE) {
+          Trace_command(rx_buffer, payload_len);
+      }
+      else if (cmd_id == CMD_STATS) {
+          Stats_sendSnapshot();
+      }
+      else if (cmd_id == CMD_MEMINFO) {
+          Stats_sendMemInfo();
+      }
+      else if (cmd_id == CMD_LIST) {
+          if (list_credit < LS_WINDOW) list_credit++; // 조각 ack
+          list_ack_at = system_ticks;
+      }
   }
+
+  // 진행 중인 ls 스트리밍이 있으면 조각 하나 전송
+  Comm_listStep(t);
 }
@@ -7,6 +7,9 @@
 // --- 통신 모듈 초기화 ---
 void Comm_init();
 
+// 통신 데몬이 정적으로 잡고 있는 버퍼 크기 (bytes, CMD_MEMINFO 용)
+uint16_t Comm_bufferBytes();
+
 // --- 통신 처리 (스케줄러나 태스크에서 호출) ---
 // Task* t는 "시스템 콜 대리 호출"을 위한 주체 태스크
 void Comm_process(Task* t);
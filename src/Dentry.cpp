@@ -0,0 +1,176 @@
+#include "Dentry.h"
+#include "HAL.h"
+
+#define DENTRY_ROOT     -1 // 루트 디렉터리 (칸 없음)
+#define DENTRY_NONE     -2 // 존재하지 않음
+#define DENTRY_UNCACHED -3 // 캐시할 수 없는 이름 -> sd.open 사용
+
+struct Dentry {
+  char name[DENTRY_NAME_LEN + 1]; // 빈 문자열 = 빈 칸
+  int8_t parent;                  // 부모 칸 (DENTRY_ROOT = 루트)
+  bool is_dir;
+  uint16_t dir_index;             // 부모 디렉터리 안의 엔트리 인덱스
+  uint32_t first_cluster;         // 열었을 때 확인용
+  uint8_t last_used;
+};
+
+static Dentry dentries[DENTRY_SLOTS];
+static uint8_t dentry_clock = 0;
+
+void Dentry_invalidate() {
+  for (int i = 0; i < DENTRY_SLOTS; i++) dentries[i].name[0] = '\0';
+}
+
+// 칸 하나를 비우고, 그 칸을 부모로 가진 자손도 모두 비움
+static void Dentry_drop(int8_t slot) {
+  dentries[slot].name[0] = '\0';
+  for (int8_t i = 0; i < DENTRY_SLOTS; i++) {
+    if (dentries[i].name[0] != '\0' && dentries[i].parent == slot) Dentry_drop(i);
+  }
+}
+
+static int8_t Dentry_find(int8_t parent, const char* name, int len) {
+  for (int8_t i = 0; i < DENTRY_SLOTS; i++) {
+    Dentry* d = &dentries[i];
+    if (d->name[0] != '\0' && d->parent == parent &&
+        (int)strlen(d->name) == len && strncasecmp(d->name, name, len) == 0) {
+      d->last_used = ++dentry_clock;
+      return i;
+    }
+  }
+  return DENTRY_NONE;
+}
+
+// 디렉터리 엔트리에서 첫 클러스터 (FatFile 에 공개 접근자가 없음, ExecCache 와 같은 방식)
+static bool Dentry_cluster(FatFile& f, uint32_t* cluster) {
+  DirFat_t dir;
+  if (!f.dirEntry(&dir)) return false;
+  *cluster = ((uint32_t)getLe16(dir.firstClusterHigh) << 16) | getLe16(dir.firstClusterLow);
+  return true;
+}
+
+static int8_t Dentry_insert(int8_t parent, const char* name, int len, FatFile& f) {
+  // 빈 칸 또는 가장 오래 안 쓴 칸 (부모 칸 자신은 제외)
+  int8_t victim = -1;
+  for (int8_t i = 0; i < DENTRY_SLOTS; i++) {
+    if (dentries[i].name[0] == '\0') { victim = i; break; }
+    if (i == parent) continue;
+    if (victim < 0 || (uint8_t)(dentry_clock - dentries[i].last_used) > (uint8_t)(dentry_clock - dentries[victim].last_used)) victim = i;
+  }
+  uint32_t cluster;
+  if (victim < 0 || !Dentry_cluster(f, &cluster)) return DENTRY_UNCACHED;
+  if (dentries[victim].name[0] != '\0') Dentry_drop(victim);
+  if (parent >= 0 && dentries[parent].name[0] == '\0') return DENTRY_UNCACHED; // 부모가 자손으로 함께 밀려남
+
+  Dentry* d = &dentries[victim];
+  memcpy(d->name, name, len);
+  d->name[len] = '\0';
+  d->parent = parent;
+  d->is_dir = f.isDir();
+  d->dir_index = f.dirIndex();
+  d->first_cluster = cluster;
+  d->last_used = ++dentry_clock;
+  return victim;
+}
+
+// 칸을 루트부터 인덱스로 차례로 열기 (스캔 없음)
+static bool Dentry_openSlot(int8_t slot, File32* out) {
+  int8_t chain[DENTRY_SLOTS];
+  uint8_t depth = 0;
+  for (int8_t s = slot; s != DENTRY_ROOT; s = dentries[s].parent) {
+    if (depth == DENTRY_SLOTS) return false;
+    chain[depth++] = s;
+  }
+
+  if (depth == 0) {
+    *out = sd.open("/", FILE_READ);
+    return (bool)*out;
+  }
+
+  // 중간 디렉터리는 두 핸들을 번갈아 쓰고, 마지막 구성 요소는 out 으로 바로 엶 (File32 는 복사 불가)
+  File32 dirs[2];
+  uint8_t k = 0;
+  dirs[0] = sd.open("/", FILE_READ);
+  if (!dirs[0]) return false;
+  while (depth > 0) {
+    Dentry* d = &dentries[chain[--depth]];
+    File32* next = (depth == 0) ? out : &dirs[k ^ 1];
+    uint32_t cluster;
+    bool ok = next->open(&dirs[k], d->dir_index, O_RDONLY) &&
+              Dentry_cluster(*next, &cluster) && cluster == d->first_cluster;
+    dirs[k].close();
+    if (!ok) {
+      if (next->isOpen()) next->close();
+      Dentry_invalidate(); // 디스크가 캐시와 다름 (외부 변경 등)
+      return false;
+    }
+    k ^= 1;
+  }
+  return true;
+}
+
+// 절대 경로 -> 칸 번호 (DENTRY_ROOT / DENTRY_NONE / DENTRY_UNCACHED)
+// 캐시에 없는 구성 요소는 부모 디렉터리 하나만 스캔해서 채움
+static int8_t Dentry_resolve(const char* path) {
+  int8_t cur = DENTRY_ROOT;
+  const char* p = path;
+
+  while (*p) {
+    while (*p == '/') p++;
+    if (!*p) break;
+    const char* end = p;
+    while (*end && *end != '/') end++;
+    int len = end - p;
+
+    if (len == 1 && p[0] == '.') {
+      // 현재 위치 유지
+    } else if (len == 2 && p[0] == '.' && p[1] == '.') {
+      if (cur != DENTRY_ROOT) cur = dentries[cur].parent;
+    } else {
+      if (cur != DENTRY_ROOT && !dentries[cur].is_dir) return DENTRY_NONE;
+      if (len > DENTRY_NAME_LEN) return DENTRY_UNCACHED;
+
+      int8_t hit = Dentry_find(cur, p, len);
+      if (hit == DENTRY_NONE) {
+        File32 dir;
+        if (!Dentry_openSlot(cur, &dir)) return DENTRY_UNCACHED;
+        char name[DENTRY_NAME_LEN + 1];
+        memcpy(name, p, len);
+        name[len] = '\0';
+
+        File32 f;
+        bool found = f.open(&dir, name, O_RDONLY);
+        dir.close();
+        if (!found) return DENTRY_NONE;
+        hit = Dentry_insert(cur, p, len, f);
+        f.close();
+        if (hit < 0) return hit;
+      }
+      cur = hit;
+    }
+    p = end;
+  }
+  return cur;
+}
+
+bool Dentry_stat(const char* abs_path, bool* is_dir) {
+  int8_t d = Dentry_resolve(abs_path);
+  if (d == DENTRY_NONE) return false;
+  if (d == DENTRY_ROOT) { *is_dir = true; return true; }
+  if (d >= 0) { *is_dir = dentries[d].is_dir; return true; }
+
+  File32 f = sd.open(abs_path, FILE_READ);
+  if (!f) return false;
+  *is_dir = f.isDir();
+  f.close();
+  return true;
+}
+
+bool Dentry_open(const char* abs_path, File32* out) {
+  int8_t d = Dentry_resolve(abs_path);
+  if (d == DENTRY_NONE) return false;
+  if (d != DENTRY_UNCACHED && Dentry_openSlot(d, out)) return true;
+
+  *out = sd.open(abs_path, FILE_READ);
+  return (bool)*out;
+}
@@ -0,0 +1,24 @@
+#ifndef DENTRY_H
+#define DENTRY_H
+
+#include "OSConfig.h"
+#include <SdFat.h>
+
+// -----------------------------------------------------------------
+// [Dentry Cache]
+// 절대 경로의 각 구성 요소를 (부모, 이름) -> (디렉터리 인덱스, 첫 클러스터, 속성)
+// 으로 기억하는 작은 트리입니다. 캐시된 경로는 디렉터리 스캔 없이
+// 루트부터 FatFile::open(dir, index) 로 바로 열리고, cd 처럼 존재 확인만
+// 필요한 경우에는 SD 접근이 전혀 없습니다.
+//
+// - 이름이 DENTRY_NAME_LEN 을 넘는 구성 요소는 캐시하지 않음 (sd.open 으로 처리)
+// - 커널이 파일/디렉터리를 만들거나 지우면 Dentry_invalidate() 를 불러야 합니다.
+// -----------------------------------------------------------------
+
+#define DENTRY_NAME_LEN 12
+
+bool Dentry_stat(const char* abs_path, bool* is_dir);   // 존재 여부 (+ 디렉터리인지)
+bool Dentry_open(const char* abs_path, File32* out);    // 읽기 전용으로 열기
+void Dentry_invalidate();
+
+#endif
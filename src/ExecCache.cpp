@@ -0,0 +1,104 @@
+#include "ExecCache.h"
+#include "Pool.h"
+#include "Trace.h"
+#include "Dentry.h"
+
+static ExecCacheEntry exec_cache[EXEC_CACHE_SLOTS];
+static uint8_t exec_cache_clock = 0;
+
+// 디렉터리 엔트리에서 변경 감지용 값 (첫 클러스터, 수정 시각, 크기) 추출
+static bool ExecCache_readStamp(File32& file, uint8_t* stamp) {
+  DirFat_t dir;
+  if (!file.dirEntry(&dir)) return false;
+  memcpy(stamp, dir.firstClusterHigh, EXEC_CACHE_STAMP_LEN);
+  return true;
+}
+
+static void ExecCache_drop(ExecCacheEntry* e) {
+  if (e->name[0] == '\0') return;
+  Pool_release(e->path);
+  e->path = NULL;
+  e->name[0] = '\0';
+}
+
+void ExecCache_init() {
+  for (int i = 0; i < EXEC_CACHE_SLOTS; i++) {
+    exec_cache[i].name[0] = '\0';
+    exec_cache[i].path = NULL;
+  }
+  exec_cache_clock = 0;
+}
+
+// 경로의 부모 디렉터리를 열고 그 안의 dir_index 엔트리를 out 으로 엶
+static bool ExecCache_reopen(const ExecCacheEntry* e, File32* out) {
+  char dir_path[32];
+  const char* slash = strrchr(e->path, '/');
+  int len = (slash == NULL || slash == e->path) ? 1 : slash - e->path;
+  if (len >= (int)sizeof(dir_path)) return false;
+  memcpy(dir_path, e->path, len);
+  dir_path[len] = '\0';
+
+  File32 dir;
+  if (!Dentry_open(dir_path, &dir)) return false;
+  bool ok = out->open(&dir, e->dir_index, O_RDONLY);
+  dir.close();
+  return ok;
+}
+
+const ExecCacheEntry* ExecCache_lookup(const char* name, File32* out) {
+  for (int i = 0; i < EXEC_CACHE_SLOTS; i++) {
+    ExecCacheEntry* e = &exec_cache[i];
+    if (e->name[0] == '\0' || strcmp(e->name, name) != 0) continue;
+
+    // 같은 자리의 같은 파일인지 확인 (디렉터리 섹터 1개, 대개 SdFat 캐시에서 처리)
+    uint8_t stamp[EXEC_CACHE_STAMP_LEN];
+    if (!ExecCache_reopen(e, out) || !ExecCache_readStamp(*out, stamp) ||
+        memcmp(stamp, e->stamp, EXEC_CACHE_STAMP_LEN) != 0) {
+      if (out->isOpen()) out->close();
+      TRACE(TRC_TASK, EV_EXEC_CACHE, 0);
+      ExecCache_drop(e);
+      return NULL;
+    }
+    e->last_used = ++exec_cache_clock;
+    TRACE(TRC_TASK, EV_EXEC_CACHE, 1);
+    return e;
+  }
+  return NULL;
+}
+
+void ExecCache_store(const char* name, const char* path, File32& file, const ExecHeader* hdr,
+                     const uint8_t* window, uint8_t window_len) {
+  if (strlen(name) >= EXEC_CACHE_NAME_LEN) return;
+
+  // 빈 칸 또는 가장 오래 안 쓴 칸
+  ExecCacheEntry* e = &exec_cache[0];
+  for (int i = 0; i < EXEC_CACHE_SLOTS; i++) {
+    ExecCacheEntry* c = &exec_cache[i];
+    if (c->name[0] == '\0' || strcmp(c->name, name) == 0) { e = c; break; }
+    if ((uint8_t)(exec_cache_clock - c->last_used) > (uint8_t)(exec_cache_clock - e->last_used)) e = c;
+  }
+  ExecCache_drop(e);
+
+  const char* p = Pool_intern(path);
+  if (p == NULL) return;
+  e->dir_index = file.dirIndex();
+  if (!ExecCache_readStamp(file, e->stamp)) {
+    Pool_release(p);
+    return;
+  }
+  strcpy(e->name, name);
+  e->path = p;
+  e->hdr = *hdr;
+  if (window_len > CODE_BUFFER_SIZE) window_len = CODE_BUFFER_SIZE;
+  memcpy(e->window, window, window_len);
+  e->window_len = window_len;
+  e->last_used = ++exec_cache_clock;
+}
+
+void ExecCache_invalidate(const char* path) {
+  for (int i = 0; i < EXEC_CACHE_SLOTS; i++) {
+    ExecCacheEntry* e = &exec_cache[i];
+    if (e->name[0] == '\0') continue;
+    if (path == NULL || strcmp(e->path, path) == 0) ExecCache_drop(e);
+  }
+}
@@ -0,0 +1,35 @@
+#ifndef EXEC_CACHE_H
+#define EXEC_CACHE_H
+
+#include "Kernel.h"
+
+// -----------------------------------------------------------------
+// [Warm Exec Cache]
+// 최근 exec 한 실행 파일의 "찾기 + 헤더 + 첫 코드 창" 결과를 명령 이름으로 보관합니다.
+// 적중 시 경로 탐색(sd.open 최대 3번), 헤더/체크섬 읽기, 첫 장전을 건너뜁니다.
+// 핸들 대신 부모 디렉터리 안의 엔트리 인덱스를 기억해 FatFile::open(dir, index) 로 다시 열고
+// (부모는 Dentry 캐시로 스캔 없이 엶), 디렉터리 엔트리 (크기/첫 클러스터/수정 시각)가
+// 저장할 때와 다르면 버립니다. (File32 는 복사할 수 없고, 사본 둘은 위치/크기가 따로 놂)
+// -----------------------------------------------------------------
+
+#define EXEC_CACHE_NAME_LEN 13
+#define EXEC_CACHE_STAMP_LEN 12 // DirFat_t firstClusterHigh ~ fileSize
+
+struct ExecCacheEntry {
+  char name[EXEC_CACHE_NAME_LEN]; // 키: 입력한 명령 이름 (빈 문자열 = 빈 칸)
+  const char* path;               // 찾은 경로 (인터닝)
+  uint16_t dir_index;             // 부모 디렉터리 안의 엔트리 인덱스
+  uint8_t stamp[EXEC_CACHE_STAMP_LEN];
+  ExecHeader hdr;                 // 검증된 헤더
+  uint8_t window_len;
+  uint8_t window[CODE_BUFFER_SIZE]; // 진입점부터의 첫 코드 창
+  uint8_t last_used;              // LRU 교체용
+};
+
+void ExecCache_init();
+const ExecCacheEntry* ExecCache_lookup(const char* name, File32* out); // 적중 시 out 으로 엶, 미스/무효화 시 NULL
+void ExecCache_store(const char* name, const char* path, File32& file, const ExecHeader* hdr,
+                     const uint8_t* window, uint8_t window_len);
+void ExecCache_invalidate(const char* path); // 파일 수정/삭제 시 호출 (NULL 이면 전체)
+
+#endif
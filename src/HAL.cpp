@@ -1,4 +1,7 @@
 #include "HAL.h"
+#include "Profiler.h"
+#include "Trace.h"
+#include "Stats.h"
 
 // -----------------------------------------------------------------
 // [1] 전역 객체 정의
@@ -8,11 +11,46 @@ SoftSpiDriver<12, 11, 13> softSpi;
 SdFat32 sd;
 #define SD_CONFIG SdSpiConfig(10, DEDICATED_SPI, SD_SCK_MHZ(0), &softSpi)
 
+// [신규] SD 카드 래퍼 - 섹터 단위 I/O 관찰 지점 (트레이스/통계)
+// 볼륨은 sd.card() 대신 이 장치 위에 마운트됩니다.
+// (platformio.ini: USE_BLOCK_DEVICE_INTERFACE=1 필요)
+class HAL_BlockDevice : public FsBlockDeviceInterface {
+ public:
+  FsBlockDevice* dev = nullptr;
+
+  void end() override { dev->end(); }
+  bool isBusy() override { return dev->isBusy(); }
+  uint32_t sectorCount() override { return dev->sectorCount(); }
+  bool syncDevice() override { return dev->syncDevice(); }
+
+  bool readSector(uint32_t sector, uint8_t* dst) override {
+    TRACE(TRC_SD, EV_SD_READ, sector);
+    kstats.sd_sectors_read++;
+    return dev->readSector(sector, dst);
+  }
+  bool readSectors(uint32_t sector, uint8_t* dst, size_t ns) override {
+    TRACE(TRC_SD, EV_SD_READ, sector);
+    kstats.sd_sectors_read += ns;
+    return dev->readSectors(sector, dst, ns);
+  }
+  bool writeSector(uint32_t sector, const uint8_t* src) override {
+    TRACE(TRC_SD, EV_SD_WRITE, sector);
+    kstats.sd_sectors_written++;
+    return dev->writeSector(sector, src);
+  }
+  bool writeSectors(uint32_t sector, const uint8_t* src, size_t ns) override {
+    TRACE(TRC_SD, EV_SD_WRITE, sector);
+    kstats.sd_sectors_written += ns;
+    return dev->writeSectors(sector, src, ns);
+  }
+};
+static HAL_BlockDevice hal_sd_dev;
+
 // 시스템 시간
 volatile unsigned long system_ticks = 0;
 
 // [신규] HAL 전용 송신 버퍼 (512로 증설)
-static uint8_t hal_tx_buffer[512];
+static uint8_t hal_tx_buffer[HAL_TX_BUFFER_SIZE];
 
 // [신규] 패킷 파싱용 버퍼 및 상태
 #define HAL_RX_RAW_SIZE 256
@@ -20,7 +58,8 @@ static uint8_t hal_raw_buffer[HAL_RX_RAW_SIZE];
 static uint32_t hal_raw_index = 0;
 
 // 파싱 완료된 패킷 (Consumer용)
-static uint8_t hal_pkt_payload[256];
+#define HAL_PKT_PAYLOAD_SIZE 256
+static uint8_t hal_pkt_payload[HAL_PKT_PAYLOAD_SIZE];
 static uint32_t hal_pkt_len = 0;
 static uint16_t hal_pkt_cmd = 0;
 static uint32_t hal_pkt_read_pos = 0; // HAL_read가 읽은 위치
@@ -36,8 +75,13 @@ void HAL_init() {
   hal_raw_index = 0;
   hal_pkt_ready = false;
 
-  // SD카드 초기화
-  if (!sd.begin(SD_CONFIG)) {
+  // SD카드 초기화 (카드 -> 래퍼 장치 -> FAT 볼륨)
+  bool sd_ok = sd.cardBegin(SD_CONFIG);
+  if (sd_ok) {
+    hal_sd_dev.dev = sd.card();
+    sd_ok = sd.FatVolume::begin(&hal_sd_dev) || sd.FatVolume::begin(&hal_sd_dev, true, 0);
+  }
+  if (!sd_ok) {
     // 패킷 시스템 초기화 전이라 그냥 보냄 (또는 에러 패킷 전송 시도)
     // Serial.println("SD Init Failed!"); 
     // HAL_write는 아직 초기화 전이라 위험할 수 있지만 시도해봄
@@ -61,6 +105,7 @@ void HAL_setupTimer() {
 // 심장 박동 (ISR)
 ISR(TIMER1_COMPA_vect) {
   system_ticks++;
+  Profiler_tick();
   // LED 깜빡임 제거 (SD카드 충돌 방지)
 }
 
@@ -68,30 +113,54 @@ ISR(TIMER1_COMPA_vect) {
 // [4] 표준 입출력 구현 (StreamProtocol 적용)
 // -----------------------------------------------------------------
 
-// 내부 헬퍼: 패킷 전송
-static void send_packet(uint16_t cmd, const char* payload) {
-    uint32_t payload_len = strlen(payload);
+// [신규] 임의 타입 패킷 전송 (바이너리 응답용)
+void HAL_sendPacket(uint16_t cmd, uint8_t payload_type, const uint8_t* payload, uint32_t payload_len) {
     uint32_t packet_len = 0;
-    
-    // PT_STRING = 1
+
     sp_result_t res = sp_encode_packet_buffer(
-        (const uint8_t*)payload, payload_len, 
-        SP_UNFRAGED, PT_STRING, cmd, 
+        payload, payload_len,
+        SP_UNFRAGED, payload_type, cmd,
         hal_tx_buffer, sizeof(hal_tx_buffer), &packet_len
     );
 
     if (res == SP_OK) {
+        TRACE(TRC_COMM, EV_PKT_TX_BEGIN, cmd);
         Serial.write(hal_tx_buffer, packet_len);
         Serial.flush(); // 즉시 전송 보장
+        TRACE(TRC_COMM, EV_PKT_TX_END, cmd);
+        kstats.pkts_tx++;
+        kstats.bytes_tx += packet_len;
     }
 }
 
+// [신규] 송신 버퍼의 payload 자리 (헤더 바로 뒤)
+uint8_t* HAL_txPayload() {
+    return hal_tx_buffer + SP_HEADER_SIZE;
+}
+
+// [신규] HAL_txPayload() 에 채운 내용을 그대로 전송 (제자리 인코딩, 복사는 같은 주소라 무해)
+void HAL_sendTxPayload(uint16_t cmd, uint8_t payload_type, uint32_t payload_len) {
+    if (payload_len > HAL_TX_PAYLOAD_MAX) return;
+    HAL_sendPacket(cmd, payload_type, HAL_txPayload(), payload_len);
+}
+
+// 내부 헬퍼: 문자열 패킷 전송
+static void send_packet(uint16_t cmd, const char* payload) {
+    HAL_sendPacket(cmd, PT_STRING, (const uint8_t*)payload, strlen(payload));
+}
+
 // [쓰기] 문자열 출력
 void HAL_write(int fd, const char* text) {
   uint16_t cmd = (fd == FD_STDERR) ? CMD_STDERR : CMD_STDOUT;
   send_packet(cmd, text);
 }
 
+// [쓰기] 길이 지정 출력 (파일 내용 등 0 바이트가 섞일 수 있는 데이터)
+void HAL_write(int fd, const uint8_t* data, uint16_t len) {
+  uint16_t cmd = (fd == FD_STDERR) ? CMD_STDERR : CMD_STDOUT;
+  HAL_sendPacket(cmd, PT_STRING, data, len);
+}
+
 // [쓰기] 숫자 출력
 void HAL_write(int fd, int num) {
   char buf[16];
@@ -122,7 +191,11 @@ static void process_serial() {
         int b = Serial.read();
         if (b < 0) break;
 
-        if (hal_raw_index >= HAL_RX_RAW_SIZE) hal_raw_index = 0; // Overflow Reset
+        if (hal_raw_index >= HAL_RX_RAW_SIZE) { // Overflow Reset
+            hal_raw_index = 0;
+            kstats.dropped_pkts++;
+        }
+        kstats.bytes_rx++;
         hal_raw_buffer[hal_raw_index++] = (uint8_t)b;
 
         if (hal_raw_index >= SP_HEADER_SIZE + 4) {
@@ -138,6 +211,8 @@ static void process_serial() {
                 memcpy(hal_pkt_payload, packet.payload, hal_pkt_len);
                 hal_pkt_read_pos = 0;
                 hal_pkt_ready = true;
+                TRACE(TRC_COMM, EV_PKT_RX, hal_pkt_cmd);
+                kstats.pkts_rx++;
 
                 // 버퍼 정리 (Sticky Packet)
                 uint32_t consumed = (uint32_t)packet.packet_length;
@@ -154,6 +229,8 @@ static void process_serial() {
                 // 더 읽어야 함
             } else {
                 // 에러 -> 리셋
+                if (res == SP_ERR_CRC_MISMATCH) kstats.crc_errors++;
+                else kstats.dropped_pkts++;
                 hal_raw_index = 0;
             }
         }
@@ -201,5 +278,10 @@ int HAL_readPacket(uint16_t* cmd_out, uint8_t* payload_out, uint32_t max_len) {
     return -1; // 패킷 없음
 }
 
+// [신규] HAL 정적 버퍼 총량 (CMD_MEMINFO RAM 예산 보고용)
+uint16_t HAL_bufferBytes() {
+    return sizeof(hal_tx_buffer) + sizeof(hal_raw_buffer) + sizeof(hal_pkt_payload);
+}
+
 // (구) 호환성 유지용 (더미)
 void HAL_pushInput(const uint8_t* data, uint32_t len) {}
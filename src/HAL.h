@@ -17,9 +17,24 @@ void HAL_setupTimer();
 // 여기가 핵심! 선언이 반드시 있어야 함
 void HAL_write(int fd, const char* text);
 void HAL_write(int fd, int num);
+void HAL_write(int fd, const uint8_t* data, uint16_t len); // 길이 지정 (중간의 0 바이트도 보냄)
 void HAL_writeChar(int fd, char c);
 int  HAL_read(int fd);
 
+// [신규] 바이너리 등 임의 타입 패킷 전송 (PT_BYTES 응답 등)
+void HAL_sendPacket(uint16_t cmd, uint8_t payload_type, const uint8_t* payload, uint32_t payload_len);
+
+// [신규] 송신 버퍼에 바로 payload 를 채워 보내기 (덤프용 정적 버퍼 대신)
+// HAL_txPayload() 에 최대 HAL_TX_PAYLOAD_MAX 바이트를 쓰고 HAL_sendTxPayload 로 보냄
+// 그 사이에 HAL_write 등 다른 송신을 하면 내용이 덮어써짐
+#define HAL_TX_BUFFER_SIZE 512
+#define HAL_TX_PAYLOAD_MAX (HAL_TX_BUFFER_SIZE - SP_HEADER_SIZE - 4) // 헤더 + CRC32
+uint8_t* HAL_txPayload();
+void HAL_sendTxPayload(uint16_t cmd, uint8_t payload_type, uint32_t payload_len);
+
+// [신규] HAL 이 정적으로 잡고 있는 버퍼 크기 합 (bytes)
+uint16_t HAL_bufferBytes();
+
 // [신규] 통신 모듈에서 입력을 넣어주는 함수
 void HAL_pushInput(const uint8_t* data, uint32_t len);
 
@@ -0,0 +1,64 @@
+#include "KFile.h"
+
+static File32 kfiles[KFILE_SLOTS];
+static uint8_t kfile_owner[KFILE_SLOTS];
+static uint8_t kfile_used = 0;  // 비트 i = 핸들 i 사용 중
+
+static_assert(KFILE_SLOTS <= 8, "kfile_used is a uint8_t bitmap");
+
+static bool KFile_valid(int8_t h) {
+  return h >= 0 && h < KFILE_SLOTS && (kfile_used & (1 << h));
+}
+
+int8_t KFile_alloc(uint8_t owner) {
+  for (int8_t i = 0; i < KFILE_SLOTS; i++) {
+    if (!(kfile_used & (1 << i))) {
+      kfile_used |= (1 << i);
+      kfile_owner[i] = owner;
+      return i;
+    }
+  }
+  return KFILE_NONE;
+}
+
+File32* KFile_get(int8_t h, uint8_t owner) {
+  return (KFile_valid(h) && kfile_owner[h] == owner) ? &kfiles[h] : NULL;
+}
+
+void KFile_free(int8_t h) {
+  if (!KFile_valid(h)) return;
+  if (kfiles[h].isOpen()) kfiles[h].close();
+  kfile_used &= ~(1 << h);
+}
+
+void KFile_releaseOwner(uint8_t owner) {
+  for (int8_t i = 0; i < KFILE_SLOTS; i++) {
+    if (KFile_valid(i) && kfile_owner[i] == owner) KFile_free(i);
+  }
+}
+
+// SdFat 은 디렉터리 엔트리 위치(클러스터)를 공개하지 않으므로 이름, 엔트리 번호, 첫 섹터로 비교
+// (빈 파일끼리 다른 디렉터리에서 모두 같으면 같은 파일로 봄: 지우기 거부 쪽으로만 틀림)
+bool KFile_isSame(File32* a, File32* b) {
+  if (!a->isOpen() || !b->isOpen()) return false;
+  if (a->dirIndex() != b->dirIndex() || a->firstSector() != b->firstSector()) return false;
+  char na[32], nb[32];
+  a->getName(na, sizeof(na));
+  b->getName(nb, sizeof(nb));
+  return strcasecmp(na, nb) == 0;
+}
+
+bool KFile_isOpen(File32* f) {
+  for (int8_t i = 0; i < KFILE_SLOTS; i++) {
+    if (KFile_valid(i) && &kfiles[i] != f && KFile_isSame(&kfiles[i], f)) return true;
+  }
+  return false;
+}
+
+uint8_t KFile_inUse() {
+  uint8_t n = 0;
+  for (int8_t i = 0; i < KFILE_SLOTS; i++) {
+    if (kfile_used & (1 << i)) n++;
+  }
+  return n;
+}
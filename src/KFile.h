@@ -0,0 +1,24 @@
+#ifndef KFILE_H
+#define KFILE_H
+
+#include "OSConfig.h"
+#include <SdFat.h>
+
+// -----------------------------------------------------------------
+// [Kernel File Handles]
+// 디렉터리 나열 등 커널이 잠깐 여는 파일 핸들을 모아 둔 작은 풀입니다.
+// 태스크가 실행 중인 코드 파일(TaskCold::file)은 건드리지 않습니다.
+// 핸들은 소유 태스크가 종료되면 Kernel_terminateTask 에서 함께 닫힙니다.
+// -----------------------------------------------------------------
+
+#define KFILE_NONE -1
+
+int8_t  KFile_alloc(uint8_t owner);  // 빈 핸들 번호 (없으면 KFILE_NONE)
+File32* KFile_get(int8_t h, uint8_t owner);  // 잘못된 번호거나 남의 핸들이면 NULL
+void    KFile_free(int8_t h);        // 닫고 반납
+void    KFile_releaseOwner(uint8_t owner);
+uint8_t KFile_inUse();
+bool    KFile_isSame(File32* a, File32* b); // 같은 디렉터리 엔트리 (이름 + 엔트리 번호 + 첫 섹터)
+bool    KFile_isOpen(File32* f);     // f 와 같은 파일을 연 핸들이 있음 (open/리다이렉트/mmap)
+
+#endif
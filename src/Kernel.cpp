@@ -2,52 +2,78 @@
 #include "HAL.h"
 #include "VirtualMachine.h"
 #include "Communication.h" // [신규] 통신 모듈
-
-// Task table
-Task tasks[TASK_COUNT];
+#include "Profiler.h"
+#include "Trace.h"
+#include "Pool.h"
+#include "ExecCache.h"
+#include "BinIndex.h"
+#include "Dentry.h"
+#include "KFile.h"
+#include "Redirect.h"
+#include "Pipe.h"
+#include "Mailbox.h"
+#include "Shm.h"
+#include "Mmap.h"
+#include "Swap.h"
+#include "Tmpfs.h"
+#include "Rom.h"
+#include <new.h> // placement new (TaskCold)
+
+// Task table: 슬롯마다 포인터 하나만 상주하고 TCB 는 쓰는 동안 커널 풀(전역 힙)에서 빌림
+// 빈 슬롯은 공용 빈 TCB(task_none, 상태 TASK_FREE)를 가리키므로 NULL 검사 없이 읽을 수 있음
+static Task task_none;
+Task* tasks[TASK_COUNT];
+
+// 현재 CPU를 쓰는 태스크 (-1: 없음). 타이머 ISR(프로파일러)에서 읽음
+volatile int8_t kernel_current_task = -1;
 
 // Global heap for VM
 int global_heap[GLOBAL_HEAP_SIZE];
 uint8_t heap_bitmap[GLOBAL_HEAP_SIZE / 8];
+int heap_used = 0; // 할당된 셀 수
+int heap_peak = 0; // heap_used 최댓값 (CMD_MEMINFO)
 
 // Function prototypes
 int Kernel_malloc(Task* t, int size);
+static void Kernel_resetTask(Task* t, int id);
 
 // --- init ---
 void Kernel_init() {
   memset(global_heap, 0, sizeof(global_heap));
   memset(heap_bitmap, 0, sizeof(heap_bitmap));
+  heap_used = 0;
+  heap_peak = 0;
+  Pool_init();
+  // 빈 슬롯은 모두 빈 TCB 를 가리킴 (TCB 는 Kernel_claimSlot 이 쓸 때 빌림)
+  Kernel_resetTask(&task_none, -1);
+  for (int i = 0; i < TASK_COUNT; i++) tasks[i] = &task_none;
+  ExecCache_init();
+  Redirect_init();
+  Pipe_init();
+  Mailbox_init();
+  Shm_init();
+  Mmap_init();
+  Swap_init(); // SD 에 스왑 파일 준비 (없으면 연속 할당)
+  Tmpfs_init(); // 전역 힙 앞쪽 TMPFS_CELLS 칸을 RAM 디스크로 고정
   
   // 통신 초기화
   Comm_init();
 
-  for (int i = 0; i < TASK_COUNT; i++) {
-    tasks[i].id = i;
-    // tasks[i].is_active = false; -> [수정]
-    tasks[i].setFree();
-    
-    tasks[i].sp = -1;
-    tasks[i].wake_up_time = 0;
-    
-    // 가상 메모리 초기화
-    tasks[i].heap_base = -1;
-    tasks[i].heap_limit = 0;
-
-    for (int j = 0; j < MAX_ALLOCATIONS; j++) {
-      tasks[i].alloc_table[j].ptr = -1;
-    }
-    strcpy(tasks[i].cwd, "/");
-  }
-
   // [Task 0] 통신 데몬 전용 설정
+  // 파일/코드 버퍼 없이 시스템 콜 인자용 작은 스택과 cwd/args 만 가짐
+  Kernel_claimSlot(0);
+  tasks[0]->stack = (int*)Pool_alloc(COMM_STACK_SIZE * sizeof(int));
+  tasks[0]->stack_size = COMM_STACK_SIZE;
+  tasks[0]->cwd = Pool_intern("/");
+  tasks[0]->args = Pool_intern("");
   // 미리 힙을 조금 할당해둠 (파라미터 전달용)
   // 예: 256 바이트 (int 128개)
-  tasks[0].setRunning(); // 항상 실행 상태
-  int comm_heap = Kernel_malloc(&tasks[0], 128); // 128 ints = 256 bytes (AVR int=2) -> 512 bytes? 
+  tasks[0]->setRunning(); // 항상 실행 상태
+  int comm_heap = Kernel_malloc(tasks[0], 128); // 128 ints = 256 bytes (AVR int=2) -> 512 bytes? 
   // AVR int=2byte, so 128 size = 256 bytes.
   if (comm_heap != -1) {
-      tasks[0].heap_base = comm_heap;
-      tasks[0].heap_limit = 128;
+      tasks[0]->heap_base = comm_heap;
+      tasks[0]->heap_limit = 128;
   }
 }
 
@@ -71,6 +97,85 @@ void resolve_path(Task* t, const char* input, char* output) {
   }
 }
 
+// [인터닝 문자열 교체] 새 문자열을 먼저 확보한 뒤 기존 것을 반납 (실패 시 기존 값 유지)
+static bool Kernel_replaceString(const char** field, const char* value) {
+  const char* s = Pool_intern(value);
+  if (s == NULL) {
+    HAL_write(FD_STDERR, "Err: Kernel pool full\n");
+    return false;
+  }
+  Pool_release(*field);
+  *field = s;
+  return true;
+}
+
+bool Kernel_setCwd(Task* t, const char* path) {
+  return Kernel_replaceString(&t->cwd, path);
+}
+
+bool Kernel_setArgs(Task* t, const char* args) {
+  return Kernel_replaceString(&t->args, args);
+}
+
+// 빈 TCB 초기값
+static void Kernel_resetTask(Task* t, int id) {
+  memset(t, 0, sizeof(Task));
+  t->id = id;
+  t->setFree();
+  t->sp = -1;
+  t->isa = EXEC_VER_STACK;
+  t->heap_base = -1; // 가상 메모리 없음
+  for (int j = 0; j < MAX_ALLOCATIONS; j++) {
+    t->alloc_table[j].ptr = -1;
+  }
+  memset(t->fds, KFILE_NONE, sizeof(t->fds));
+}
+
+Task* Kernel_claimSlot(int id) {
+  if (tasks[id] != &task_none) return tasks[id];
+  Task* t = (Task*)Pool_alloc(sizeof(Task));
+  if (t == NULL) {
+    HAL_write(FD_STDERR, "Error: Out of Memory (Task slot)\n");
+    return NULL;
+  }
+  Kernel_resetTask(t, id);
+  tasks[id] = t;
+  return t;
+}
+
+void Kernel_dropSlot(int id) {
+  Task* t = tasks[id];
+  if (t == &task_none || t->isActive() || t->cold != NULL || t->stack != NULL) return;
+  if (t->heap_limit != 0) return;
+  for (int j = 0; j < MAX_ALLOCATIONS; j++) {
+    if (t->alloc_table[j].ptr != -1) return; // 체크포인트 재개가 미리 잡은 블록
+  }
+  tasks[id] = &task_none;
+  Pool_free(t, sizeof(Task));
+}
+
+// TCB cold 부분(파일/코드 버퍼, 스택, 문자열)을 커널 풀에 반납
+static void Kernel_releaseTaskMemory(Task* t) {
+  if (t->cold != NULL) {
+    t->cold->file.close();
+    t->cold->~TaskCold();
+    Pool_free(t->cold, sizeof(TaskCold) + t->code_buf_size);
+    t->cold = NULL;
+    t->code_buf_size = 0;
+  }
+  if (t->stack != NULL) {
+    Pool_free(t->stack, t->stack_size * sizeof(int));
+    t->stack = NULL;
+    t->stack_size = 0;
+  }
+  Pool_release(t->filename);
+  Pool_release(t->args);
+  Pool_release(t->cwd);
+  t->filename = NULL;
+  t->args = NULL;
+  t->cwd = NULL;
+}
+
 void Kernel_initMemory() {
   memset(heap_bitmap, 0, sizeof(heap_bitmap));
 }
@@ -81,8 +186,14 @@ bool is_allocated(int idx) {
 }
 
 void set_allocated(int idx, bool allocated) {
-  if (allocated) heap_bitmap[idx / 8] |= (1 << (idx % 8));
-  else           heap_bitmap[idx / 8] &= ~(1 << (idx % 8));
+  if (is_allocated(idx) == allocated) return;
+  if (allocated) {
+    heap_bitmap[idx / 8] |= (1 << (idx % 8));
+    if (++heap_used > heap_peak) heap_peak = heap_used;
+  } else {
+    heap_bitmap[idx / 8] &= ~(1 << (idx % 8));
+    heap_used--;
+  }
 }
 
 void set_bit(int index) {
@@ -93,10 +204,8 @@ void clear_bit(int index) {
   heap_bitmap[index / 8] &= ~(1 << (index % 8));
 }
 
-// heap alloc (first-fit)
-int Kernel_malloc(Task* t, int size) {
-  if (size <= 0) return -1;
-
+// heap cells first-fit (스왑 없이) - 실패 시 -1
+static int Kernel_findCells(int size) {
   int consecutive_free = 0;
   int start_index = -1;
 
@@ -106,219 +215,445 @@ int Kernel_malloc(Task* t, int size) {
       consecutive_free++;
 
       if (consecutive_free == size) {
-        int slot = -1;
-        for (int k = 0; k < MAX_ALLOCATIONS; k++) {
-          if (t->alloc_table[k].ptr == -1) {
-            slot = k;
-            break;
-          }
-        }
-
-        if (slot == -1) {
-          HAL_write(FD_STDERR, "Err: Alloc table full\n");
-          return -1;
-        }
-
         for (int k = 0; k < size; k++) {
           set_allocated(start_index + k, true);
         }
-
-        t->alloc_table[slot].ptr = start_index;
-        t->alloc_table[slot].size = size;
-
         return start_index;
       }
     } else {
       consecutive_free = 0;
     }
   }
-
   return -1;
 }
 
+// heap cells alloc (first-fit, 소유 태스크 없음) - 실패 시 -1
+// 자리가 없으면 쉬는 태스크의 세그먼트를 하나씩 스왑 파일로 내보내며 다시 찾음
+int Kernel_allocCells(int size) {
+  if (size <= 0) return -1;
+  int start_index = Kernel_findCells(size);
+  while (start_index == -1 && Swap_outVictim()) start_index = Kernel_findCells(size);
+  return start_index;
+}
+
+void Kernel_freeCells(int ptr, int size) {
+  for (int k = 0; k < size; k++) {
+    set_allocated(ptr + k, false);
+  }
+}
+
+// heap alloc (first-fit)
+int Kernel_malloc(Task* t, int size) {
+  if (size <= 0) return -1;
+
+  int slot = -1;
+  for (int k = 0; k < MAX_ALLOCATIONS; k++) {
+    if (t->alloc_table[k].ptr == -1) {
+      slot = k;
+      break;
+    }
+  }
+
+  if (slot == -1) {
+    HAL_write(FD_STDERR, "Err: Alloc table full\n");
+    return -1;
+  }
+
+  int start_index = Kernel_allocCells(size);
+  if (start_index != -1) {
+    t->alloc_table[slot].ptr = start_index;
+    t->alloc_table[slot].size = size;
+  }
+
+  TRACE(TRC_MEM, EV_MALLOC, start_index);
+  return start_index;
+}
+
 // heap free
 void Kernel_free(Task* t, int ptr) {
   for (int i = 0; i < MAX_ALLOCATIONS; i++) {
     if (t->alloc_table[i].ptr == ptr) {
-      int size = t->alloc_table[i].size;
-
-      for (int k = 0; k < size; k++) {
-        set_allocated(ptr + k, false);
-      }
+      Kernel_freeCells(ptr, t->alloc_table[i].size);
 
       t->alloc_table[i].ptr = -1;
+      TRACE(TRC_MEM, EV_FREE, ptr);
       return;
     }
   }
 }
 
-bool Kernel_loadTask(int id, const char* input_name, const char* arg_str, const char* parent_cwd, const char* parent_arg_str) { // parent_arg_str 추가
-  Task* t = &tasks[id];
-  if (t->file) t->file.close(); 
-  
-  // 인자 저장
-  memset(t->args, 0, 32);
-  // (기존 arg_str 처리)
-  if (arg_str != NULL) {
-      strncpy(t->args, arg_str, 31);
+// heap handoff: 블록을 옮기지 않고 alloc_table 항목만 from -> to 로 이동
+// 성공 시 블록 크기, from 의 블록이 아니거나 to 의 표가 가득 차면 -1
+int Kernel_giveBlock(Task* from, Task* to, int ptr) {
+  int src = -1, dst = -1;
+  for (int i = 0; i < MAX_ALLOCATIONS; i++) {
+    if (src == -1 && ptr != -1 && from->alloc_table[i].ptr == ptr) src = i;
+    if (dst == -1 && to->alloc_table[i].ptr == -1) dst = i;
   }
-  // [부모 인자 상속] 부모 인자 문자열이 있으면 자식의 t->args를 초기화
-  if (parent_arg_str != NULL) {
-      strncpy(t->args, parent_arg_str, 31);
+  if (src == -1 || dst == -1) return -1;
+
+  to->alloc_table[dst] = from->alloc_table[src];
+  from->alloc_table[src].ptr = -1;
+  return to->alloc_table[dst].size;
+}
+
+// heap alloc at a fixed address (체크포인트 재개: 블록 주소가 태스크 힙에 그대로 남아 있음)
+// 한 칸이라도 차 있거나 표가 가득 차면 false
+bool Kernel_claimCells(int ptr, int size) {
+  if (ptr < 0 || size <= 0 || ptr + size > GLOBAL_HEAP_SIZE) return false;
+  for (int k = 0; k < size; k++) {
+    if (is_allocated(ptr + k)) return false;
   }
+  for (int k = 0; k < size; k++) set_allocated(ptr + k, true);
+  return true;
+}
 
-  // [CWD 상속] 부모 CWD가 있으면 자식의 CWD를 초기화
-  memset(t->cwd, 0, 32);
-  if (parent_cwd != NULL) {
-      strncpy(t->cwd, parent_cwd, 31);
-  } else {
-      strcpy(t->cwd, "/"); // 기본값 루트
+static uint16_t get16(const uint8_t* p) { return p[0] | (p[1] << 8); }
+
+// [실행 파일 헤더 해석] buf 는 파일 앞 avail 바이트 (확장 헤더면 EXEC_EXT_HEADER_SIZE 필요)
+// 실패 시 에러를 출력하고 false
+static bool Kernel_parseHeader(const uint8_t* buf, uint8_t avail, uint32_t file_size, ExecHeader* h) {
+  if (avail < EXEC_HEADER_SIZE) {
+    HAL_write(FD_STDERR, "Err: Invalid exec format (Too short)\n");
+    return false;
   }
 
-  // ---------------------------------------------------------
-  // [파일 찾기 로직 3단계]
-  // ---------------------------------------------------------
-  char path_buffer[32]; // 경로 조립용 버퍼
-  memset(path_buffer, 0, 32);
+  uint8_t ver = buf[1] & ~EXEC_VER_EXT;
+  if (buf[0] != EXEC_MAGIC || (ver != EXEC_VER_STACK && ver != EXEC_VER_REG)) {
+    HAL_write(FD_STDERR, "Err: Invalid exec format (Bad Magic)\n");
+    return false;
+  }
 
-  // [시도 1] 입력한 이름 그대로 (예: "my_script.txt")
-  strcpy(path_buffer, input_name);
-  t->file = sd.open(path_buffer, FILE_READ);
+  // 기본 헤더: 파일 나머지 전체가 코드
+  h->isa = ver;
+  h->heap = get16(&buf[2]);
+  h->hdr_size = EXEC_HEADER_SIZE;
+  h->stack = VM_STACK_SIZE;
+  h->flags = 0;
+  h->code_size = (uint16_t)(file_size - EXEC_HEADER_SIZE);
+  h->entry = 0;
+  h->rodata_len = 0;
+  if (!(buf[1] & EXEC_VER_EXT)) return true;
+
+  // 확장 헤더
+  if (avail < EXEC_EXT_HEADER_SIZE) {
+    HAL_write(FD_STDERR, "Err: Invalid exec format (Too short)\n");
+    return false;
+  }
+  h->hdr_size = buf[4];
+  if (buf[5] != 0) h->stack = buf[5];
+  h->flags = buf[6];
+  h->code_size = get16(&buf[8]);
+  h->entry = get16(&buf[10]);
+  h->rodata_len = get16(&buf[12]);
+
+  if (h->hdr_size < EXEC_EXT_HEADER_SIZE || h->code_size == 0 || h->entry >= h->code_size ||
+      (uint32_t)h->hdr_size + h->code_size + h->rodata_len != file_size) {
+    HAL_write(FD_STDERR, "Err: Invalid exec format (Bad layout)\n");
+    return false;
+  }
+  return true;
+}
 
-  // [시도 2] .bin 붙이기 (예: "ls" -> "ls.bin")
-  if (!t->file) {
-    strcpy(path_buffer, input_name);
-    strcat(path_buffer, ".bin");
-    t->file = sd.open(path_buffer, FILE_READ);
+// [실행 파일 헤더 읽기] 헤더를 해석하고 확장 헤더면 체크섬까지 검사
+// 실패 시 에러를 출력하고 false (파일 위치는 정의되지 않음)
+static bool Kernel_readHeader(File32& file, ExecHeader* h) {
+  uint8_t buf[EXEC_EXT_HEADER_SIZE];
+  int avail = file.read(buf, sizeof(buf));
+  if (!Kernel_parseHeader(buf, (avail > 0) ? avail : 0, file.fileSize(), h)) return false;
+  if (!(buf[1] & EXEC_VER_EXT)) return true;
+  uint32_t crc = (uint32_t)get16(&buf[16]) | ((uint32_t)get16(&buf[18]) << 16);
+
+  // 체크섬 (code + rodata) - 손상/반쯤 복사된 실행 파일을 실행 전에 거름
+  uint8_t chunk[32];
+  uint32_t c = 0xFFFFFFFFUL;
+  int n;
+  file.seek(h->hdr_size);
+  while ((n = file.read(chunk, sizeof(chunk))) > 0) c = sp_crc32_update(c, chunk, n);
+  if (~c != crc) {
+    HAL_write(FD_STDERR, "Err: Invalid exec format (Checksum)\n");
+    return false;
   }
+  return true;
+}
 
-  // [시도 3] /bin/ 폴더 뒤지기 (예: "ls" -> "/bin/ls.bin")
-  if (!t->file) {
-    strcpy(path_buffer, "/bin/");
-    strcat(path_buffer, input_name);
-    strcat(path_buffer, ".bin");
-    t->file = sd.open(path_buffer, FILE_READ);
+// [ROM 실행 파일 헤더] 체크섬은 vmtools.py rom 이 이미지를 만들 때 검사함 (플래시는 바뀌지 않음)
+static bool Kernel_readRomHeader(const RomEntry* e, ExecHeader* h) {
+  uint8_t buf[EXEC_EXT_HEADER_SIZE];
+  uint8_t avail = (e->size < sizeof(buf)) ? e->size : sizeof(buf);
+  Rom_read(e->offset, buf, avail);
+  return Kernel_parseHeader(buf, avail, e->size, h);
+}
+
+// [실행 파일 찾기] PATH 순서: /bin -> /
+// - '/' 나 '.' 이 들어간 이름은 경로로 보고 그대로 엶 (예: "test.bin", "/usr/prog.bin")
+// - 명령 이름은 /bin 색인(해시 1회 + 인덱스로 열기) -> 루트의 name.bin
+// - 둘 다 없던 이름은 음성 캐시에 남아 다음부터 SD 접근 없이 실패
+// 찾은 경로는 path_buffer(32) 에 남음
+static File32 Kernel_findExecutable(const char* input_name, char* path_buffer) {
+  File32 file;
+
+  if (strchr(input_name, '/') != NULL || strchr(input_name, '.') != NULL) {
+    if (input_name[0] != '/') strcpy(path_buffer, "/"); // 볼륨 기준 상대 경로
+    strncat(path_buffer, input_name, 31 - strlen(path_buffer));
+    Dentry_open(path_buffer, &file);
+    return file;
   }
 
-  // ---------------------------------------------------------
-  // [결과 처리]
-  // ---------------------------------------------------------
-  if (t->file) {
-    // [헤더 읽기 및 힙 크기 결정]
-    // 모든 실행 파일은 반드시 헤더(4바이트)를 가져야 함
-    uint8_t header[4];
-    int size = DEFAULT_TASK_HEAP_SIZE;
-    
-    if (t->file.read(header, 4) == 4) {
-      if (header[0] == 0xAD && header[1] == 0x01) {
-        // 헤더 발견! (Magic: 0xAD, Ver: 0x01)
-        size = header[2] | (header[3] << 8);
-      } else {
-        HAL_write(FD_STDERR, "Err: Invalid exec format (Bad Magic)\n");
-        t->file.close();
-        t->setFree();
-        return false;
-      }
-    } else {
-        HAL_write(FD_STDERR, "Err: Invalid exec format (Too short)\n");
-        t->file.close();
-        t->setFree();
-        return false;
-    }
+  if (BinIndex_open(input_name, &file, path_buffer)) return file;
+  if (BinIndex_isMissing(input_name) || strlen(input_name) > 26) return file;
 
-    // ---------------------------------------------------------
-    // [가상 메모리 할당]
-    // 태스크 실행 전에 전용 힙 공간(Segment)을 확보합니다.
-    // ---------------------------------------------------------
-    int consecutive_free = 0;
-    int start_index = -1;
-    bool alloc_success = false;
-
-    for (int i = 0; i < GLOBAL_HEAP_SIZE; i++) {
-      if (!is_allocated(i)) {
-        if (consecutive_free == 0) start_index = i;
-        consecutive_free++;
-        if (consecutive_free == size) {
-          // 찾았다! 할당 수행
-          for (int k = 0; k < size; k++) set_allocated(start_index + k, true);
-          t->heap_base = start_index;
-          t->heap_limit = size;
-          alloc_success = true;
-          break;
-        }
-      } else {
-        consecutive_free = 0;
-      }
+  strcpy(path_buffer, "/");
+  strcat(path_buffer, input_name);
+  strcat(path_buffer, ".bin");
+  file = sd.open(path_buffer, FILE_READ);
+  if (!file) BinIndex_noteMissing(input_name);
+  return file;
+}
+
+// 로드 실패: 잡아 둔 cold 부분과 (다른 것을 잡고 있지 않으면) 슬롯 TCB 를 반납
+static bool Kernel_failLoad(Task* t) {
+  Kernel_releaseTaskMemory(t);
+  t->setFree();
+  Kernel_dropSlot(t->id);
+  return false;
+}
+
+bool Kernel_loadTask(int id, const char* input_name, const char* arg_str, const char* parent_cwd, const char* parent_arg_str) { // parent_arg_str 추가
+  Task* t = Kernel_claimSlot(id); // TCB 를 빌림 (빈 슬롯이면 커널 풀에서)
+  if (t == NULL) return false;
+  Kernel_releaseTaskMemory(t); // 이전 실행의 잔여물 정리
+
+  File32 file;
+  ExecHeader hdr;
+  char path_buffer[32]; // 경로 조립용 버퍼
+  memset(path_buffer, 0, 32);
+
+  // [ROM] 플래시에 구운 실행 파일이 있으면 SD 보다 먼저 (XIP, 파일/코드 버퍼 없음)
+  RomEntry rom;
+  const ExecCacheEntry* cached = NULL;
+  bool xip = Rom_entry(Rom_find(input_name), &rom);
+  if (xip) {
+    if (!Kernel_readRomHeader(&rom, &hdr)) {
+      return Kernel_failLoad(t);
+    }
+    strcpy(path_buffer, ROM_MOUNT "/");
+    strncat(path_buffer, rom.name, 31 - strlen(path_buffer));
+  }
+  // [웜 캐시] 최근 실행한 명령이면 경로 탐색/헤더 검사/첫 장전을 건너뜀
+  else if ((cached = ExecCache_lookup(input_name, &file)) != NULL) {
+    hdr = cached->hdr;
+    strncpy(path_buffer, cached->path, 31);
+  } else {
+    file = Kernel_findExecutable(input_name, path_buffer);
+    if (!file) {
+      HAL_write(FD_STDERR, "Error: Command not found\n"); 
+      return Kernel_failLoad(t);
     }
 
-    if (!alloc_success) {
-        HAL_write(FD_STDERR, "Error: Out of Memory (Cannot alloc task heap)\n");
-        t->file.close();
-        // t->is_active = false; -> [수정]
-        t->setFree();
-        return false;
+    // [헤더 읽기] 힙/스택/코드 버퍼 크기 결정
+    // 모든 실행 파일은 반드시 헤더(최소 4바이트)를 가져야 함
+    if (!Kernel_readHeader(file, &hdr)) {
+      file.close();
+      return Kernel_failLoad(t);
     }
+  }
+  t->isa = hdr.isa;
+  int size = hdr.heap;
+
+  // 코드 버퍼: 코드가 작으면 그만큼만, PRELOAD 면 코드 전체 (점프/재장전 시 SD 접근 없음)
+  uint8_t buf_size = (hdr.code_size < CODE_BUFFER_SIZE) ? hdr.code_size : CODE_BUFFER_SIZE;
+  if ((hdr.flags & EXEC_FLAG_PRELOAD) && hdr.code_size <= EXEC_PRELOAD_MAX) buf_size = hdr.code_size;
+  if (buf_size == 0) buf_size = 1;
+  if (xip) buf_size = 0; // 플래시에서 바로 fetch
+
+  // [TCB cold 부분 할당] 파일 핸들 + 코드 버퍼
+  void* cold_mem = Pool_alloc(sizeof(TaskCold) + buf_size);
+  if (cold_mem == NULL) {
+    HAL_write(FD_STDERR, "Error: Out of Memory (Kernel pool)\n");
+    file.close();
+    return Kernel_failLoad(t);
+  }
+  t->cold = new (cold_mem) TaskCold();
+  t->cold->file = static_cast<File32&&>(file); // File32 는 복사 불가, 핸들을 넘김
+  t->cold->rom_code = xip ? rom.offset + hdr.hdr_size : 0;
+  t->code_buf_size = buf_size;
+  t->code_start = hdr.hdr_size;
+  t->code_size = hdr.code_size;
+  t->rodata_len = hdr.rodata_len;
+  uint8_t stack_size = hdr.stack;
+
+  // [VM 스택 / 문자열 할당] (커널 풀)
+  t->stack = (int*)Pool_alloc(stack_size * sizeof(int));
+  if (t->stack != NULL) t->stack_size = stack_size;
+
+  // [부모 인자 상속] 부모 인자 문자열이 있으면 그것을 우선 사용
+  // [CWD 상속] 부모 CWD가 있으면 같은 인터닝 문자열을 공유 (없으면 루트)
+  t->filename = Pool_intern(path_buffer);
+  t->args = Pool_intern((parent_arg_str != NULL) ? parent_arg_str : arg_str);
+  t->cwd = Pool_intern((parent_cwd != NULL) ? parent_cwd : "/");
+
+  if (t->stack == NULL || t->filename == NULL || t->args == NULL || t->cwd == NULL) {
+    HAL_write(FD_STDERR, "Error: Out of Memory (Kernel pool)\n");
+    return Kernel_failLoad(t);
+  }
 
-    // 성공! 최종 경로 저장
-    memset(t->filename, 0, 128);
-    // 파일명이 너무 길면(8.3 제한) 잘릴 수 있으니 주의
-    // 여기선 전체 경로 대신 파일명만 남기거나, 필요하면 전체 경로 저장
-    // 일단 간단하게 input_name을 저장하거나, 찾은 path_buffer를 저장
-    strncpy(t->filename, path_buffer, 127);
+  // ---------------------------------------------------------
+  // [가상 메모리 할당]
+  // 태스크 실행 전에 전용 힙 공간(Segment)을 확보합니다.
+  // (자리가 없으면 잠든/기다리는 태스크 세그먼트를 스왑 파일로 내보냄)
+  // ---------------------------------------------------------
+  int start_index = Kernel_allocCells(size);
+  if (start_index != -1) {
+    t->heap_base = start_index;
+    t->heap_limit = size;
+  }
+
+  if (start_index == -1) {
+      HAL_write(FD_STDERR, "Error: Out of Memory (Cannot alloc task heap)\n");
+      return Kernel_failLoad(t);
+  }
 
+  // 코드 버퍼 첫 장전 (진입점부터, 캐시 적중 시 캐시된 창을 복사)
+  // XIP 는 장전 없이 buffer_index 가 곧 PC (buffer_pos = 0)
+  if (xip) {
+    t->buffer_index = hdr.entry;
+    t->buffer_pos = 0;
+  } else {
     t->buffer_index = 0;
-    // 코드 버퍼 읽기 (이미 헤더 4바이트 읽었으므로 포인터는 4에 있음)
-    t->file.read(t->code_buffer, CODE_BUFFER_SIZE);
+    t->buffer_pos = hdr.entry;
+    uint8_t warm = 0;
+    if (cached != NULL) {
+      warm = (cached->window_len < t->code_buf_size) ? cached->window_len : t->code_buf_size;
+      memcpy(t->cold->code_buffer, cached->window, warm);
+    }
+    t->cold->file.seek(t->code_start + hdr.entry + warm);
+    if (warm < t->code_buf_size) t->cold->file.read(t->cold->code_buffer + warm, t->code_buf_size - warm);
+    if (cached == NULL) ExecCache_store(input_name, path_buffer, t->cold->file, &hdr, t->cold->code_buffer, t->code_buf_size);
+  }
     
-    // t->is_active = true; -> [수정]
-    t->setRunning();
+  // t->is_active = true; -> [수정]
+  t->setRunning();
     
-    t->sp = -1;
-    t->wake_up_time = 0;
+  t->sp = -1;
+  t->stack_hwm = 0;
+  memset(t->regs, 0, sizeof(t->regs));
+  t->wake_up_time = 0;
+  memset(&t->stats, 0, sizeof(TaskStats));
 
-    HAL_write(FD_STDOUT, "\n");
-    return true;
-  } else {
-    HAL_write(FD_STDERR, "Error: Command not found\n"); 
-    return false;
-  }
+  TRACE(TRC_TASK, EV_TASK_LOAD, id);
+
+  HAL_write(FD_STDOUT, "\n");
+  return true;
 }
 
 // scheduler
 void Kernel_runScheduler() {
+  int8_t last_vm_task = -1; // 트레이스용: 마지막으로 실행한 VM 태스크
   while(1) {
     for (int i = 0; i < TASK_COUNT; i++) {
-        Task* t = &tasks[i];
+        Task* t = tasks[i];
         
         // 실행 가능한 상태(RUNNING)가 아니면 건너뜀 (PAUSED 포함)
         if (!t->isRunnable()) continue;
 
         // [Task 0] 통신 데몬 (VM 대신 C++ 코드 실행)
         if (i == 0) {
+            t->stats.turns++;
+            kernel_current_task = 0;
             Comm_process(t);
+            kernel_current_task = -1;
             continue;
         }
 
         if (t->wake_up_time > 0) {
             if (system_ticks < t->wake_up_time) continue;
-            else t->wake_up_time = 0;
+            else {
+                t->wake_up_time = 0;
+                t->stats.sleep_ms += system_ticks - t->stats.state_since;
+                t->stats.state_since = 0;
+            }
         }
 
-        VM_runStep(t);
+        // 스왑으로 내보낸 세그먼트는 실행 직전에 읽어 옴 (자리가 없으면 다음 차례에 재시도)
+        if (t->isSwapped() && !Swap_in(t)) continue;
+
+        t->stats.turns++;
+
+        kernel_current_task = i;
+        if (last_vm_task != i) {
+            TRACE(TRC_SCHED, EV_TASK_SWITCH, i);
+            last_vm_task = i;
+        }
+        if (t->isa == EXEC_VER_REG) VM_runStepReg(t);
+        else VM_runStep(t);
+        kernel_current_task = -1;
+
+        if (!t->isActive()) { // 이번 스텝에서 종료됨
+          Kernel_releaseTaskMemory(t);
+          Kernel_dropSlot(i);
+        }
     }
   }
 }
 
-// IO bridge
-void Kernel_stdWrite(int fd, int val) { HAL_write(fd, val); }
-void Kernel_stdWrite(int fd, const char* str) { HAL_write(fd, str); }
-void Kernel_stdWriteChar(int fd, char c) { HAL_writeChar(fd, c); }
-int  Kernel_stdRead(int fd) { return HAL_read(fd); }
+// IO bridge (실행 중인 태스크의 fd 1/2 가 파이프나 파일/RAM 디스크에 연결되어 있으면 그쪽으로)
+static bool Kernel_redirect(int fd, const char* str, uint16_t len) {
+  if (kernel_current_task <= 0) return false;
+  Task* t = tasks[kernel_current_task];
+  if (Pipe_isEnd(t->fds[fd])) {
+    Pipe_stdWrite(t, t->fds[fd], (const uint8_t*)str, len);
+    return true;
+  }
+  if (Tmpfs_isEnd(t->fds[fd])) {
+    Tmpfs_write(t->fds[fd], (const uint8_t*)str, len); // 가득 차면 나머지는 버림
+    return true;
+  }
+  return Redirect_write(t, fd, (const uint8_t*)str, len);
+}
+void Kernel_stdWrite(int fd, int val) {
+  char buf[8];
+  itoa(val, buf, 10);
+  if (!Kernel_redirect(fd, buf, strlen(buf))) HAL_write(fd, buf);
+}
+void Kernel_stdWrite(int fd, const char* str) {
+  if (!Kernel_redirect(fd, str, strlen(str))) HAL_write(fd, str);
+}
+void Kernel_stdWriteChar(int fd, char c) {
+  if (!Kernel_redirect(fd, &c, 1)) HAL_writeChar(fd, c);
+}
+int  Kernel_stdRead(int fd) {
+  // 파이프에 연결된 stdin: 비어 있으면 막힘 (VM 이 READ 를 재실행), EOF 면 -1
+  if (kernel_current_task > 0 && Pipe_isEnd(tasks[kernel_current_task]->fds[fd])) {
+    Task* t = tasks[kernel_current_task];
+    int c;
+    return (Pipe_read(t, t->fds[fd], &c, 1) == 1) ? c : -1;
+  }
+
+  int val = HAL_read(fd);
+
+  // [통계] 입력이 없어 헛도는 시간을 blocked 로 집계
+  if (kernel_current_task > 0) {
+    TaskStats* st = &tasks[kernel_current_task]->stats;
+    if (val == -1) {
+      if (st->state_since == 0) st->state_since = system_ticks;
+    } else if (st->state_since != 0) {
+      st->blocked_ms += system_ticks - st->state_since;
+      st->state_since = 0;
+    }
+  }
+  return val;
+}
 
 // code buffer helpers
 void Kernel_refillBuffer(Task* t) {
-  if (t->file.available()) {
-    t->file.read(t->code_buffer, CODE_BUFFER_SIZE);
+  File32& file = t->cold->file;
+  uint32_t pos = file.curPosition() - t->code_start;
+  if (pos < t->code_size) { // 코드 영역 끝(= rodata 시작)을 넘으면 종료
+    t->buffer_pos = (uint16_t)pos;
+    TRACE(TRC_CODE, EV_REFILL, t->buffer_pos);
+    t->stats.refills++;
+    file.read(t->cold->code_buffer, t->code_buf_size);
     t->buffer_index = 0;
   } else {
     Kernel_terminateTask(t->id);
@@ -326,13 +661,112 @@ void Kernel_refillBuffer(Task* t) {
 }
 
 void Kernel_jump(Task* t, int addr) {
-  // [수정] 헤더(4바이트)를 고려하여 오프셋 추가
-  t->file.seek(addr + 4);
-  t->buffer_index = CODE_BUFFER_SIZE;
+  // XIP: PC 만 옮김 (코드 끝을 넘으면 다음 fetch 에서 종료)
+  if (t->code_buf_size == 0) {
+    t->buffer_index = addr;
+    return;
+  }
+
+  // 대상이 이미 코드 버퍼 창 안에 있으면 SD 접근 없이 인덱스만 이동 (짧은 루프, PRELOAD)
+  // 파일 위치는 창 끝에 그대로 있으므로 이후 재장전도 올바름
+  if (addr >= t->buffer_pos && addr < t->buffer_pos + t->code_buf_size && addr < t->code_size) {
+    t->buffer_index = addr - t->buffer_pos;
+    return;
+  }
+
+  // 헤더 크기를 고려하여 오프셋 추가
+  TRACE(TRC_CODE, EV_SEEK, addr);
+  t->stats.seeks++;
+  t->cold->file.seek(addr + t->code_start);
+  t->buffer_index = t->code_buf_size;
+}
+
+// [rodata 읽기] 코드 파일의 rodata 영역 [off, off+len) 을 dst 로 복사 (rodata 끝에서 잘림)
+// 코드 스트림의 파일 위치는 보존합니다. 리턴: 읽은 바이트 수 (-1: 범위 밖)
+int Kernel_readRodata(Task* t, uint16_t off, uint8_t* dst, int len) {
+  if (t->cold == NULL || off >= t->rodata_len || len < 0) return -1;
+  if (len > t->rodata_len - off) len = t->rodata_len - off;
+
+  if (t->code_buf_size == 0) { // XIP: 플래시의 코드 바로 뒤
+    Rom_read(t->cold->rom_code + t->code_size + off, dst, len);
+    return len;
+  }
+
+  File32& file = t->cold->file;
+  uint32_t pos = file.curPosition();
+  file.seek((uint32_t)t->code_start + t->code_size + off);
+  int n = file.read(dst, len);
+  file.seek(pos);
+  return n;
+}
+
+// [파일 시스템 변경 알림] 커널이 SD 에 파일/디렉터리를 만들거나 고치거나 지운 뒤 호출
+// (경로 기반 캐시들을 무효화. path 가 NULL 이면 전체)
+void Kernel_onFsWrite(const char* path) {
+  ExecCache_invalidate(path);
+  BinIndex_invalidate(path);
+  Dentry_invalidate();
+}
+
+void Kernel_block(Task* t) {
+  t->block();
+}
+
+void Kernel_wakeBlocked() {
+  for (int i = 0; i < TASK_COUNT; i++) {
+    if (tasks[i]->task_state == TASK_BLOCKED) tasks[i]->setRunning();
+  }
+}
+
+// [데이터 파일 열기] 읽기 전용은 dentry 캐시 경유,
+// 쓰기는 부모 디렉터리만 캐시로 열고 그 안에서 생성/열기 (생성/비우기 시 경로 캐시 무효화)
+bool Kernel_openFile(const char* abs_path, oflag_t oflag, File32* out) {
+  if ((oflag & (O_WRONLY | O_RDWR)) == 0) {
+    return Dentry_open(abs_path, out) && !out->isDir();
+  }
+
+  char dir_path[64];
+  strncpy(dir_path, abs_path, sizeof(dir_path) - 1);
+  dir_path[sizeof(dir_path) - 1] = '\0';
+  char* slash = strrchr(dir_path, '/');
+  if (slash == NULL || slash[1] == '\0') return false;
+  const char* leaf = abs_path + (slash - dir_path) + 1;
+  if (slash == dir_path) slash[1] = '\0'; // 루트 바로 아래
+  else *slash = '\0';
+
+  // 있는 파일은 O_CREAT 없이 먼저 열어 봄 (새로 만들었는지 구분, 스캔은 한 번)
+  File32 dir;
+  if (!Dentry_open(dir_path, &dir)) return false;
+  bool created = false;
+  bool ok = out->open(&dir, leaf, oflag & ~O_CREAT);
+  if (!ok && (oflag & O_CREAT)) ok = created = out->open(&dir, leaf, oflag);
+  dir.close();
+  if (!ok || out->isDir()) {
+    out->close();
+    return false;
+  }
+  // 경로 캐시는 디렉터리 엔트리가 생기거나 첫 클러스터가 바뀔 때만 무효화
+  // (이어 쓰기, 리다이렉트, 스왑 파일처럼 있는 파일에 쓰는 경우는 그대로 둠)
+  if (created || (oflag & O_TRUNC)) Kernel_onFsWrite(abs_path);
+  else ExecCache_invalidate(abs_path); // 실행 파일을 제자리에서 고쳐 쓸 수 있으므로 그 항목만 버림
+  return true;
+}
+
+// [열린 파일 검사] 지우기 전에: 커널 핸들(open/리다이렉트/mmap), 스왑 파일, 실행 중인 코드 파일
+// (스왑으로 나간 태스크도 cold 부분과 코드 파일은 그대로 열려 있음)
+bool Kernel_isFileBusy(File32* f) {
+  if (KFile_isOpen(f) || Swap_isFile(f)) return true;
+  for (int i = 0; i < TASK_COUNT; i++) {
+    TaskCold* cold = tasks[i]->cold;
+    if (cold != NULL && KFile_isSame(&cold->file, f)) return true;
+  }
+  return false;
 }
 
 void Kernel_terminateTask(int id) {
-  Task* t = &tasks[id];
+  Task* t = tasks[id];
+  if (t == &task_none) return; // 빈 슬롯
+  TRACE(TRC_TASK, EV_TASK_EXIT, id);
 
   // 1. 추가 할당된 메모리 해제 (alloc_table)
   for (int i = 0; i < MAX_ALLOCATIONS; i++) {
@@ -356,29 +790,52 @@ void Kernel_terminateTask(int id) {
       t->heap_base = -1;
       t->heap_limit = 0;
   }
+  t->heap_limit = 0; // 스왑된 세그먼트는 파일에 남은 내용을 버림
 
   // [수정] 종료 전, 나를 기다리는 부모가 있다면 깨워준다!
   for (int i = 0; i < TASK_COUNT; i++) {
-    if (tasks[i].getWaitingFor() == id) {
-      tasks[i].setRunning(); // 부모 깨움
+    if (tasks[i]->getWaitingFor() == id) {
+      tasks[i]->setRunning(); // 부모 깨움
     }
   }
 
+  // 리다이렉트 버퍼 비우고 마무리 후, 태스크가 빌려 쓴 커널 파일 핸들 반납 (열린 fd 자동 닫기)
+  Redirect_close(t, FD_STDOUT);
+  Redirect_close(t, FD_STDERR);
+  Pipe_releaseTask(t);
+  Mailbox_releaseTask(t);
+  Shm_releaseTask(t);
+  Mmap_releaseTask(t); // 더러운 페이지를 쓴 뒤 KFile 반납
+  KFile_releaseOwner(id);
+  Tmpfs_releaseOwner(id);
+  memset(t->fds, KFILE_NONE, sizeof(t->fds));
+
   // t->is_active = false; -> [수정]
   t->setFree();
-  t->file.close();
+  // 파일 닫기 + 스택/문자열/TCB 반납
+  // 실행 중인 태스크 자신이면 명령 처리가 끝난 뒤 스케줄러가 반납 (남은 스택/TCB 접근 보호)
+  if (id != kernel_current_task) {
+    Kernel_releaseTaskMemory(t);
+    Kernel_dropSlot(id);
+  }
+  else if (t->cold != NULL) t->cold->file.close();
   // HAL_write(FD_STDOUT, "Task Exit.\n"); // 출력 제거
 }
 
 void Kernel_yield(Task* t) {
+  t->stats.state_since = system_ticks;
   t->wake_up_time = system_ticks + t->wake_up_time;
 }
 
 // 가상 주소 -> 물리 주소 변환
 int Kernel_getPhysAddr(Task* t, int virt_addr) {
   if (virt_addr >= 0 && virt_addr < t->heap_limit) {
-    return t->heap_base + virt_addr;
+    return t->isSwapped() ? -1 : t->heap_base + virt_addr;
   }
+  // 파일 매핑 창은 힙이 아님 (LOAD/STORE 가 Mmap 페이지 캐시로 처리)
+  if (virt_addr >= MMAP_VBASE) return -1;
+  // 공유 세그먼트 창 (붙이지 않았거나 세그먼트 밖이면 -1)
+  if (virt_addr >= SHM_VBASE) return Shm_physAddr(t, virt_addr);
   // MALLOC 등으로 얻은 절대 주소는 그대로 반환
   return virt_addr;
 }
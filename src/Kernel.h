@@ -4,12 +4,29 @@
 #include "Task.h"
 #include <StreamProtocol.h> // [신규] 통신 라이브러리 추가
 
-extern Task tasks[TASK_COUNT];
+// 실행 파일 헤더 해석 결과 (기본 헤더는 기본값으로 채움, OSConfig.h 참고)
+struct ExecHeader {
+  uint8_t  isa;        // EXEC_VER_STACK / EXEC_VER_REG
+  uint8_t  hdr_size;   // 코드 시작 위치
+  uint8_t  stack;      // VM 스택 크기 (int)
+  uint8_t  flags;      // EXEC_FLAG_*
+  uint16_t heap;       // 태스크 힙 크기 (int)
+  uint16_t code_size;
+  uint16_t entry;
+  uint16_t rodata_len;
+};
+
+extern Task* tasks[TASK_COUNT]; // 빈 슬롯은 공용 빈 TCB (isActive() == false)
 extern int global_heap[GLOBAL_HEAP_SIZE];
+extern volatile int8_t kernel_current_task;
+extern int heap_used;
+extern int heap_peak;
 
 // 커널에서 VM이 호출하는 함수들
 void Kernel_init();
 void Kernel_processCommunication(); // [신규] 통신 처리 함수
+Task* Kernel_claimSlot(int id); // 빈 슬롯에 TCB 를 커널 풀에서 빌림 (이미 있으면 그대로, 실패 시 NULL)
+void  Kernel_dropSlot(int id);  // 비었고 아무것도 잡고 있지 않은 슬롯의 TCB 반납
 bool Kernel_loadTask(int id, const char* filename, const char* args = NULL, const char* parent_cwd = NULL, const char* parent_arg_str = NULL);
 void Kernel_runScheduler(); // loop()에서 이거 하나만 부르면 됨
 
@@ -21,11 +38,24 @@ int  Kernel_stdRead(int fd);
 void Kernel_systemCall(Task* t, int sys_id);
 void Kernel_refillBuffer(Task* t);
 void Kernel_jump(Task* t, int addr);
+int  Kernel_readRodata(Task* t, uint16_t off, uint8_t* dst, int len);
+void Kernel_onFsWrite(const char* path); // SD 쓰기 후 경로 캐시 무효화 (ExecCache/BinIndex/Dentry)
+void Kernel_block(Task* t);   // 실행 중인 명령을 막힘 처리 (VM 이 되감아 재시도)
+void Kernel_wakeBlocked();     // 막힌 태스크를 모두 깨움 (조건은 재시도에서 다시 검사)
+bool Kernel_openFile(const char* abs_path, oflag_t oflag, File32* out);
+bool Kernel_isFileBusy(File32* f); // 다른 핸들(open/리다이렉트/mmap), 스왑 파일, 태스크 코드 파일로 열려 있음 // 데이터 파일 열기 (디렉터리면 실패, 만들거나 비우면 경로 캐시 무효화)
 void Kernel_yield(Task* t);
 void Kernel_terminateTask(int id);
 void resolve_path(Task* t, const char* input, char* output);
+bool Kernel_setCwd(Task* t, const char* path);   // 인터닝 문자열 교체 (실패 시 false, 기존 값 유지)
+bool Kernel_setArgs(Task* t, const char* args);
 
 // [메모리 헬퍼]
 int Kernel_getPhysAddr(Task* t, int virt_addr);
+int Kernel_allocCells(int size);              // 소유 태스크 없는 전역 힙 칸 할당 (실패 시 -1)
+void Kernel_freeCells(int ptr, int size);
+int Kernel_giveBlock(Task* from, Task* to, int ptr); // MALLOC 블록 소유권 이전 (크기, 실패 시 -1)
+bool Kernel_claimCells(int ptr, int size);    // 정해진 주소의 칸 잡기 (체크포인트 재개, 한 칸이라도 차 있으면 false)
+void Kernel_free(Task* t, int ptr);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,98 @@
+#include "Mailbox.h"
+#include "Kernel.h"
+
+struct MboxMsg {
+  int8_t   to;     // 받는 태스크 ID (-1 = 빈 칸)
+  int8_t   from;   // 보낸 태스크 ID
+  int8_t   len;    // 복사 길이 또는 MBOX_LEN_BLOCK
+  uint16_t seq;    // 보낸 순서 (같은 대상끼리 FIFO)
+  int      words[MBOX_WORDS];
+};
+
+static_assert(MBOX_WORDS >= 2, "block messages carry [ptr, size]");
+
+static MboxMsg msgs[MBOX_SLOTS];
+static uint16_t next_seq;
+
+void Mailbox_init() {
+  for (int i = 0; i < MBOX_SLOTS; i++) msgs[i].to = -1;
+  next_seq = 0;
+}
+
+void Mailbox_releaseTask(Task* t) {
+  for (int i = 0; i < MBOX_SLOTS; i++) {
+    if (msgs[i].to == t->id) msgs[i].to = -1;
+  }
+}
+
+// 대상 태스크 확인 (통신 데몬/자기 자신/빈 슬롯은 불가), 없으면 NULL
+static Task* Mailbox_target(Task* t, int dst) {
+  if (dst == MBOX_PARENT) dst = t->parent;
+  if (dst <= 0 || dst >= TASK_COUNT || dst == t->id) return NULL;
+  return tasks[dst]->isActive() ? tasks[dst] : NULL;
+}
+
+static MboxMsg* Mailbox_freeSlot() {
+  for (int i = 0; i < MBOX_SLOTS; i++) {
+    if (msgs[i].to == -1) return &msgs[i];
+  }
+  return NULL;
+}
+
+static void Mailbox_post(MboxMsg* m, Task* from, Task* to) {
+  m->to = to->id;
+  m->from = from->id;
+  m->seq = next_seq++;
+  Kernel_wakeBlocked(); // 받는 쪽 재시도
+}
+
+int Mailbox_send(Task* t, int dst, const int* words, int len) {
+  Task* to = Mailbox_target(t, dst);
+  if (to == NULL || len < 0 || len > MBOX_WORDS) return -1;
+
+  MboxMsg* m = Mailbox_freeSlot();
+  if (m == NULL) return MBOX_BLOCK;
+
+  memcpy(m->words, words, len * sizeof(int));
+  m->len = len;
+  Mailbox_post(m, t, to);
+  return 0;
+}
+
+int Mailbox_sendBlock(Task* t, int dst, int ptr) {
+  Task* to = Mailbox_target(t, dst);
+  if (to == NULL) return -1;
+
+  // 칸을 먼저 확인 (막혀서 재시도할 때 소유권이 이미 넘어가 있으면 안 됨)
+  MboxMsg* m = Mailbox_freeSlot();
+  if (m == NULL) return MBOX_BLOCK;
+
+  int size = Kernel_giveBlock(t, to, ptr);
+  if (size < 0) return -1;
+
+  m->words[0] = ptr;
+  m->words[1] = size;
+  m->len = MBOX_LEN_BLOCK;
+  Mailbox_post(m, t, to);
+  return 0;
+}
+
+int Mailbox_recv(Task* t, int* dst, int max_len, int* sender) {
+  MboxMsg* m = NULL;
+  for (int i = 0; i < MBOX_SLOTS; i++) {
+    if (msgs[i].to != t->id) continue;
+    // seq 는 돌아가므로 차이로 비교
+    if (m == NULL || (int16_t)(msgs[i].seq - m->seq) < 0) m = &msgs[i];
+  }
+  if (m == NULL) return MBOX_BLOCK;
+
+  int len = m->len;
+  int n = (len == MBOX_LEN_BLOCK) ? 2 : len;
+  if (n > max_len) n = max_len;
+  memcpy(dst, m->words, n * sizeof(int));
+  *sender = m->from;
+
+  m->to = -1;
+  Kernel_wakeBlocked(); // 칸이 비었음 (보내는 쪽 재시도)
+  return len;
+}
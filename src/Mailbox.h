@@ -0,0 +1,34 @@
+#ifndef MAILBOX_H
+#define MAILBOX_H
+
+#include "Task.h"
+
+// -----------------------------------------------------------------
+// [메일박스]
+// 태스크 간 메시지 전달. 커널 메모리의 메시지 칸(MBOX_SLOTS 개)을 모든 태스크가 나눠 쓰고,
+// 칸마다 받는 태스크 ID 와 보낸 순서(seq)를 기록해 태스크별 FIFO 로 꺼냅니다.
+//
+// 복사 메시지: MBOX_WORDS 개 이하의 int 를 칸에 복사합니다.
+// 블록 메시지: MALLOC 블록의 alloc_table 항목을 보낼 때 받는 쪽으로 옮기고 주소/크기만 전달합니다
+//             (바이트 이동 없음, 받기 전에 받는 쪽이 끝나도 그 태스크의 GC 가 반납).
+//
+// 막힘: 칸이 모두 찼으면 보내기가, 자기 앞 메시지가 없으면 받기가 태스크를 TASK_BLOCKED 로 만들고
+// VM 은 그 명령을 되감아 깨어난 뒤 다시 실행합니다 (메시지가 들어가거나 빠지면 막힌 태스크를 모두 깨움).
+// -----------------------------------------------------------------
+
+#define MBOX_PARENT    -1   // 보내기 대상: exec 한 태스크 (Task::parent)
+#define MBOX_BLOCK     -2   // 보내기/받기: 막힘 (명령 재시도)
+#define MBOX_LEN_BLOCK -1   // 받기 결과 길이: 블록 메시지 (버퍼에 [주소, 크기])
+
+void Mailbox_init();
+void Mailbox_releaseTask(Task* t);   // t 앞으로 온 메시지를 버림 (태스크 종료)
+
+// 복사 메시지 보내기: 0 = 성공, -1 = 대상 없음/길이 오류, MBOX_BLOCK
+int  Mailbox_send(Task* t, int dst, const int* words, int len);
+// 블록 메시지 보내기 (ptr = 자기 MALLOC 블록): 0 = 성공, -1 = 대상 없음/자기 블록 아님/대상 표 가득, MBOX_BLOCK
+int  Mailbox_sendBlock(Task* t, int dst, int ptr);
+// 받기: 복사 메시지면 길이 (max_len 까지만 복사, 나머지는 버림), 블록 메시지면 MBOX_LEN_BLOCK, 없으면 MBOX_BLOCK
+//   *sender 에 보낸 태스크 ID
+int  Mailbox_recv(Task* t, int* dst, int max_len, int* sender);
+
+#endif
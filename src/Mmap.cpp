@@ -0,0 +1,237 @@
+#include "Mmap.h"
+#include "Kernel.h"
+#include "KFile.h"
+
+struct MmapMap {
+  int8_t owner;         // 태스크 ID (-1 = 빈 칸)
+  int8_t kfile;         // KFile 핸들 (태스크 소유)
+  uint8_t flags;
+  uint16_t first_page;  // 창 0 번 칸의 파일 페이지
+  uint16_t len;         // 창 크기 (칸)
+};
+
+struct MmapFrame {
+  int8_t map;           // 매핑 번호 (-1 = 빈 프레임)
+  bool dirty;
+  uint16_t page;        // 파일 페이지 번호
+  uint16_t used;        // LRU 시각 (클수록 최근)
+};
+
+#define MMAP_FRAME_CELLS ((MMAP_FRAMES * MMAP_FRAME_SIZE + 1) / 2) // 전역 힙 칸 (칸당 2 bytes)
+static_assert(MMAP_FRAME_CELLS <= GLOBAL_HEAP_SIZE / 2, "mmap frames would take over half of the global heap");
+static_assert(MMAP_FRAMES >= 2, "one frame thrashes when two pages are touched alternately");
+static_assert(512 % MMAP_FRAME_SIZE == 0, "a frame must not straddle an SD sector");
+
+static MmapMap maps[MMAP_SLOTS];
+static MmapFrame frames[MMAP_FRAMES];
+static uint8_t* frame_data = NULL; // 전역 힙에서 빌린 프레임 내용 (매핑이 하나라도 있을 때만)
+static int frame_base = -1;
+static uint16_t lru_clock = 0;
+
+MmapStats mmap_stats;
+
+void Mmap_init() {
+  for (int i = 0; i < MMAP_SLOTS; i++) maps[i].owner = -1;
+  for (int i = 0; i < MMAP_FRAMES; i++) frames[i].map = -1;
+  frame_data = NULL;
+  frame_base = -1;
+  memset(&mmap_stats, 0, sizeof(mmap_stats));
+}
+
+static uint8_t* Mmap_data(const MmapFrame* fr) {
+  return frame_data + (fr - frames) * MMAP_FRAME_SIZE;
+}
+
+// 첫 매핑 때 프레임 내용을 전역 힙에서 빌림 (Tmpfs 와 같은 방식, 자리가 없으면 스왑으로 비움)
+static bool Mmap_borrowFrames() {
+  if (frame_data != NULL) return true;
+  frame_base = Kernel_allocCells(MMAP_FRAME_CELLS);
+  if (frame_base == -1) return false;
+  frame_data = (uint8_t*)&global_heap[frame_base];
+  return true;
+}
+
+// 남은 매핑이 없으면 빌린 칸을 돌려줌 (프레임은 매핑을 풀 때 이미 비워짐)
+static void Mmap_returnFrames() {
+  if (frame_data == NULL) return;
+  for (int i = 0; i < MMAP_SLOTS; i++) {
+    if (maps[i].owner != -1) return;
+  }
+  for (int i = 0; i < MMAP_FRAMES; i++) frames[i].map = -1;
+  Kernel_freeCells(frame_base, MMAP_FRAME_CELLS);
+  frame_data = NULL;
+  frame_base = -1;
+}
+
+static int Mmap_find(Task* t) {
+  for (int i = 0; i < MMAP_SLOTS; i++) {
+    if (maps[i].owner == t->id) return i;
+  }
+  return -1;
+}
+
+// 더러운 프레임을 파일에 씀 (창 끝을 넘는 부분은 쓰지 않음)
+static bool Mmap_writeBack(MmapFrame* fr) {
+  if (!fr->dirty) return true;
+  MmapMap* m = &maps[fr->map];
+  File32* f = KFile_get(m->kfile, m->owner);
+  uint32_t start = (uint32_t)fr->page * MMAP_FRAME_SIZE;
+  uint32_t end = (uint32_t)m->first_page * MMAP_FRAME_SIZE + m->len;
+  uint16_t n = (end - start < MMAP_FRAME_SIZE) ? (uint16_t)(end - start) : MMAP_FRAME_SIZE;
+  if (f == NULL) return false;
+  // 파일 끝 너머 페이지면 사이를 0 으로 채워 늘림 (seekSet 은 파일 끝을 넘지 못함)
+  while (f->fileSize() < start) {
+    static const uint8_t zeros[32] = {0};
+    uint32_t gap = start - f->fileSize();
+    if (!f->seekEnd() || f->write(zeros, (gap < sizeof(zeros)) ? gap : sizeof(zeros)) <= 0) return false;
+  }
+  if (!f->seekSet(start) || f->write(Mmap_data(fr), n) != n) return false;
+  fr->dirty = false;
+  mmap_stats.writebacks++;
+  return true;
+}
+
+// 매핑 하나의 프레임을 모두 쓰고 비움
+static void Mmap_flush(int mi) {
+  for (int i = 0; i < MMAP_FRAMES; i++) {
+    if (frames[i].map != mi) continue;
+    if (!Mmap_writeBack(&frames[i])) {
+      Kernel_stdWrite(FD_STDERR, "Err: mmap write-back failed\n");
+    }
+    frames[i].map = -1;
+  }
+  File32* f = KFile_get(maps[mi].kfile, maps[mi].owner);
+  if (f != NULL) f->sync();
+}
+
+static void Mmap_touch(MmapFrame* fr) {
+  if (++lru_clock == 0) { // 시각이 한 바퀴 돌면 모두 0 으로 (순서는 잠시 흐려짐)
+    for (int i = 0; i < MMAP_FRAMES; i++) frames[i].used = 0;
+    lru_clock = 1;
+  }
+  fr->used = lru_clock;
+}
+
+// 창 오프셋 -> 그 페이지를 담은 프레임 (없으면 LRU 프레임을 비우고 읽어 옴)
+static MmapFrame* Mmap_frame(int mi, uint16_t off) {
+  MmapMap* m = &maps[mi];
+  uint16_t page = m->first_page + off / MMAP_FRAME_SIZE;
+
+  MmapFrame* victim = &frames[0];
+  for (int i = 0; i < MMAP_FRAMES; i++) {
+    MmapFrame* fr = &frames[i];
+    if (fr->map == mi && fr->page == page) {
+      mmap_stats.hits++;
+      Mmap_touch(fr);
+      return fr;
+    }
+    if (fr->map == -1) {
+      if (victim->map != -1) victim = fr;
+    } else if (victim->map != -1 && fr->used < victim->used) {
+      victim = fr;
+    }
+  }
+
+  mmap_stats.misses++;
+  if (victim->map != -1 && !Mmap_writeBack(victim)) return NULL;
+  victim->map = -1;
+
+  File32* f = KFile_get(m->kfile, m->owner);
+  if (f == NULL || !f->seekSet((uint32_t)page * MMAP_FRAME_SIZE)) return NULL;
+  uint8_t* data = Mmap_data(victim);
+  int n = f->read(data, MMAP_FRAME_SIZE);
+  if (n < 0) return NULL;
+  memset(data + n, 0, MMAP_FRAME_SIZE - n); // 파일 끝 너머는 0
+  victim->map = mi;
+  victim->page = page;
+  victim->dirty = false;
+  Mmap_touch(victim);
+  return victim;
+}
+
+int Mmap_map(Task* t, const char* path, uint16_t page, uint16_t len, uint8_t flags) {
+  int mi = Mmap_find(t);
+  if (path == NULL && mi == -1) return -1;
+  // 창만 옮길 때는 처음 연 모드를 넘을 수 없음 (읽기 전용으로 연 파일)
+  if (path == NULL && (flags & MMAP_WRITE) && !(maps[mi].flags & MMAP_WRITE)) return -1;
+
+  if (mi != -1) {
+    Mmap_flush(mi); // 창을 옮기거나 다른 파일로 바꾸기 전에 씀
+    if (path != NULL) {
+      KFile_free(maps[mi].kfile);
+      maps[mi].owner = -1;
+      mi = -1;
+    }
+  }
+
+  if (mi == -1) {
+    for (int i = 0; i < MMAP_SLOTS; i++) {
+      if (maps[i].owner == -1) { mi = i; break; }
+    }
+    int8_t h = (mi != -1 && Mmap_borrowFrames()) ? KFile_alloc(t->id) : KFILE_NONE;
+    File32* f = KFile_get(h, t->id);
+    if (f == NULL || !Kernel_openFile(path, (flags & MMAP_WRITE) ? (O_RDWR | O_CREAT) : O_RDONLY, f)) {
+      KFile_free(h);
+      Mmap_returnFrames();
+      return -1;
+    }
+    maps[mi].owner = t->id;
+    maps[mi].kfile = h;
+  }
+
+  MmapMap* m = &maps[mi];
+  File32* f = KFile_get(m->kfile, t->id);
+  uint32_t start = (uint32_t)page * MMAP_FRAME_SIZE;
+  if (len == 0) { // 파일 끝까지 (창 크기 한도)
+    uint32_t size = f->fileSize();
+    uint32_t rest = (size > start) ? size - start : 0;
+    len = (rest < MMAP_WINDOW) ? (uint16_t)rest : MMAP_WINDOW;
+  }
+  // 읽기 전용은 파일 안쪽만, 쓰기 가능은 파일 끝 너머로 늘려 쓸 수 있음
+  if (len == 0 || len > MMAP_WINDOW ||
+      (!(flags & MMAP_WRITE) && start + len > f->fileSize())) {
+    KFile_free(m->kfile);
+    m->owner = -1;
+    Mmap_returnFrames();
+    return -1;
+  }
+  m->first_page = page;
+  m->len = len;
+  m->flags = flags;
+  return MMAP_VBASE;
+}
+
+int Mmap_unmap(Task* t, int vaddr) {
+  int mi = Mmap_find(t);
+  if (mi == -1 || vaddr != MMAP_VBASE) return -1;
+  Mmap_flush(mi);
+  KFile_free(maps[mi].kfile);
+  maps[mi].owner = -1;
+  Mmap_returnFrames();
+  return 0;
+}
+
+void Mmap_releaseTask(Task* t) {
+  Mmap_unmap(t, MMAP_VBASE);
+}
+
+bool Mmap_load(Task* t, int vaddr, int* out) {
+  int mi = Mmap_find(t);
+  int off = vaddr - MMAP_VBASE;
+  if (mi == -1 || off < 0 || off >= maps[mi].len) return false;
+  MmapFrame* fr = Mmap_frame(mi, off);
+  if (fr == NULL) return false;
+  *out = Mmap_data(fr)[off % MMAP_FRAME_SIZE];
+  return true;
+}
+
+bool Mmap_store(Task* t, int vaddr, int val) {
+  int mi = Mmap_find(t);
+  int off = vaddr - MMAP_VBASE;
+  if (mi == -1 || off < 0 || off >= maps[mi].len || !(maps[mi].flags & MMAP_WRITE)) return false;
+  MmapFrame* fr = Mmap_frame(mi, off);
+  if (fr == NULL) return false;
+  Mmap_data(fr)[off % MMAP_FRAME_SIZE] = (uint8_t)val;
+  fr->dirty = true;
+  return true;
+}
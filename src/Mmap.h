@@ -0,0 +1,42 @@
+#ifndef MMAP_H
+#define MMAP_H
+
+#include "Task.h"
+
+// -----------------------------------------------------------------
+// [파일 매핑]
+// SD 파일의 한 구간을 태스크의 가상 주소 창 MMAP_VBASE.. 에 묶습니다 (태스크당 하나).
+// 창의 한 칸은 파일의 한 바이트 (읽으면 0~255, 쓰면 하위 8비트)이고 LOAD/STORE 만 통합니다.
+// 배열 명령과 시스템 콜 버퍼 인자는 힙 주소만 받습니다 (Kernel_getPhysAddr 가 -1).
+//
+// 실제 데이터는 MMAP_FRAMES 개의 MMAP_FRAME_SIZE 바이트 프레임 (페이지 캐시) 에만 올라옵니다.
+// 프레임 내용은 첫 매핑 때 전역 힙에서 빌리고 마지막 매핑이 풀리면 돌려줍니다 (정적 RAM 은 머리만).
+// 없는 페이지를 건드리면 가장 오래 안 쓴 프레임을 비우고 (더러우면 파일에 먼저 씀) 읽어 옵니다.
+// 더러운 프레임은 munmap, 창 옮기기, 태스크 종료 때도 파일에 씁니다.
+// -----------------------------------------------------------------
+
+#define MMAP_WRITE 0x01  // mmap 플래그: 쓰기 가능 (없으면 읽기 전용, STORE 는 SegFault)
+
+static_assert(SHM_VBASE + SHM_SLOTS * GLOBAL_HEAP_SIZE <= MMAP_VBASE, "SHM window overlaps mmap window");
+static_assert((long)MMAP_VBASE + MMAP_WINDOW <= 0x8000L, "mmap window must fit in positive int");
+
+// 페이지 캐시 통계 (CMD_STATS 스냅샷 끝에 실림)
+struct MmapStats {
+  uint32_t hits;
+  uint32_t misses;
+  uint32_t writebacks;  // 파일에 쓴 더러운 프레임 수
+};
+
+extern MmapStats mmap_stats;
+
+void Mmap_init();
+// 묶기: 창 시작 주소, 실패 (자리/핸들 없음, 파일 없음, 범위 오류) 시 -1
+//   path: 절대 경로 (NULL 이면 지금 묶인 파일을 그대로 쓰고 창만 옮김)
+//   page: 파일 시작 페이지 (MMAP_FRAME_SIZE 단위), len: 칸 수 (0 = 파일 끝까지, 최대 MMAP_WINDOW)
+int  Mmap_map(Task* t, const char* path, uint16_t page, uint16_t len, uint8_t flags);
+int  Mmap_unmap(Task* t, int vaddr);   // 0 = 성공, -1 = 묶인 창 시작 주소가 아님
+void Mmap_releaseTask(Task* t);        // 더러운 프레임을 쓰고 풀기 (태스크 종료, KFile 반납 전)
+bool Mmap_load(Task* t, int vaddr, int* out);   // 창 밖이거나 I/O 오류면 false
+bool Mmap_store(Task* t, int vaddr, int val);   // 읽기 전용이거나 창 밖이면 false
+
+#endif
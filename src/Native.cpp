@@ -0,0 +1,97 @@
+#include "Native.h"
+#include "HAL.h"
+
+extern void Kernel_terminateTask(int id);
+
+// -----------------------------------------------------------------
+// [네이티브 함수 구현]
+// -----------------------------------------------------------------
+static bool Native_mul(Task* t, int* args) {
+  args[0] = args[0] * args[1];
+  return true;
+}
+
+static bool Native_div(Task* t, int* args) {
+  if (args[1] == 0) return false; // 0으로 나누기
+  args[0] = args[0] / args[1];
+  return true;
+}
+
+static bool Native_mod(Task* t, int* args) {
+  if (args[1] == 0) return false;
+  args[0] = args[0] % args[1];
+  return true;
+}
+
+static bool Native_abs(Task* t, int* args) {
+  if (args[0] < 0) args[0] = -args[0];
+  return true;
+}
+
+// [] -> [ticks_lo, ticks_hi] (system_ticks, ms)
+static bool Native_millis(Task* t, int* args) {
+  noInterrupts();
+  unsigned long now = system_ticks;
+  interrupts();
+  args[0] = (int)(now & 0xFFFF);
+  args[1] = (int)((now >> 16) & 0xFFFF);
+  return true;
+}
+
+// -----------------------------------------------------------------
+// [등록 테이블] 새 함수는 여기에 한 줄 추가 (id == 인덱스)
+// Flash(PROGMEM)에 두어 SRAM을 쓰지 않습니다.
+// -----------------------------------------------------------------
+static constexpr NativeEntry native_table[] PROGMEM = {
+  { NATIVE_MUL,    2, 1, Native_mul    },
+  { NATIVE_DIV,    2, 1, Native_div    },
+  { NATIVE_MOD,    2, 1, Native_mod    },
+  { NATIVE_ABS,    1, 1, Native_abs    },
+  { NATIVE_MILLIS, 0, 2, Native_millis },
+};
+
+#define NATIVE_COUNT (int)(sizeof(native_table) / sizeof(native_table[0]))
+
+// 테이블의 id 가 인덱스와 일치하는지 컴파일 타임에 검사
+static constexpr bool native_table_is_dense(int i = 0) {
+  return (i >= NATIVE_COUNT) ? true
+       : (native_table[i].id == i && native_table_is_dense(i + 1));
+}
+static_assert(native_table_is_dense(), "native_table ids must match their index");
+
+bool Native_call(Task* t, int id) {
+  if (id < 0 || id >= NATIVE_COUNT) {
+    HAL_write(FD_STDERR, "Err: Unknown native ");
+    HAL_write(FD_STDERR, id);
+    HAL_write(FD_STDERR, "\n");
+    Kernel_terminateTask(t->id);
+    return false;
+  }
+
+  NativeEntry entry;
+  memcpy_P(&entry, &native_table[id], sizeof(entry));
+
+  // Arity 검사: 인자가 스택에 충분한지, 결과를 쓸 공간이 있는지
+  int base = t->sp - entry.argc + 1;
+  if (base < 0) {
+    HAL_write(FD_STDERR, "Err: Stack Underflow\n");
+    Kernel_terminateTask(t->id);
+    return false;
+  }
+  if (base + entry.retc > t->stack_size) {
+    HAL_write(FD_STDERR, "Err: Stack Overflow\n");
+    Kernel_terminateTask(t->id);
+    return false;
+  }
+
+  if (!entry.fn(t, &t->stack[base])) {
+    HAL_write(FD_STDERR, "Err: Native fault ");
+    HAL_write(FD_STDERR, id);
+    HAL_write(FD_STDERR, "\n");
+    Kernel_terminateTask(t->id);
+    return false;
+  }
+
+  t->sp = base + entry.retc - 1;
+  return true;
+}
@@ -0,0 +1,36 @@
+#ifndef NATIVE_H
+#define NATIVE_H
+
+#include "Task.h"
+
+// -----------------------------------------------------------------
+// [Native Function Interface]
+// 펌웨어(C++) 함수를 바이트코드에서 `NATIVE id` 로 직접 호출합니다.
+// 인자는 태스크 스택에서 그대로 넘어가고(복사 없음), 결과도 같은 자리에 씁니다.
+//
+//   호출 전 스택: [... a0 a1 .. a(argc-1)]   (a0 이 가장 먼저 PUSH 된 값)
+//   호출 후 스택: [... r0 r1 .. r(retc-1)]
+//
+// 네이티브 함수는 args[] 를 모두 읽은 뒤 args[0..retc-1] 에 결과를 씁니다.
+// false 를 리턴하면 태스크는 "Native fault" 로 종료됩니다.
+// -----------------------------------------------------------------
+typedef bool (*NativeFn)(Task* t, int* args);
+
+struct NativeEntry {
+  uint8_t  id;    // NATIVE 명령의 피연산자 (테이블 인덱스와 같아야 함)
+  uint8_t  argc;  // 스택에서 소비하는 인자 수
+  uint8_t  retc;  // 스택에 남기는 결과 수
+  NativeFn fn;
+};
+
+// --- Native IDs (vmtools.py NATIVES 와 일치해야 함) ---
+#define NATIVE_MUL     0
+#define NATIVE_DIV     1
+#define NATIVE_MOD     2
+#define NATIVE_ABS     3
+#define NATIVE_MILLIS  4
+
+// 네이티브 호출 (arity 검사 포함). 실패 시 태스크를 종료하고 false 리턴
+bool Native_call(Task* t, int id);
+
+#endif
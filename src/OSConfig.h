@@ -4,11 +4,85 @@
 #include <Arduino.h>
 
 // --- 시스템 설정 ---
-#define TASK_COUNT 3                // 동시 실행 프로그램 수
+#ifndef TASK_COUNT
+#define TASK_COUNT 8                // 태스크 슬롯 수 (슬롯당 포인터 2 bytes 상주, 빌드 플래그로 변경)
+#endif                              // TCB 는 쓰는 슬롯만 커널 풀(전역 힙)에서 빌리므로 실제 동시 실행 수는 힙이 결정
 #define CODE_BUFFER_SIZE 32         // 코드 스트리밍 탄창 크기
-#define VM_STACK_SIZE 64            // VM 스택 크기 (128 -> 64 축소)
-#define GLOBAL_HEAP_SIZE 1024       // 공유 힙 int 1024개
+#define VM_STACK_SIZE 64            // 기본 VM 스택 크기 (int 단위, 최대 255)
+#define COMM_STACK_SIZE 8           // 통신 데몬(Task 0) 스택 크기 (시스템 콜 인자 전달용)
+#define GLOBAL_HEAP_SIZE 1280       // 공유 힙 int 1280개 (태스크 세그먼트 + 커널 풀 + /tmp + mmap 프레임, 8의 배수)
 #define DEFAULT_TASK_HEAP_SIZE 256  // [수정] 태스크당 기본 할당 힙 크기 (int 단위)
+#define VM_REG_COUNT 8              // v2(레지스터) VM 레지스터 수 (2의 거듭제곱)
+
+// --- 커널 풀 (TCB, cold 부분: 파일 핸들/코드 버퍼, VM 스택, 경로 문자열) ---
+// 별도 정적 영역 없이 전역 힙 칸을 빌림 (Pool.h)
+// 태스크 하나당 TCB 약 104 + cold 부분 약 80 + 스택 (헤더 stack * 2) + 인터닝 문자열 bytes
+#define POOL_STR_SLOTS 16           // 인터닝 문자열 최대 개수
+
+// --- 실행 파일 헤더 ---
+// 기본: [Magic 0xAD][Version][HeapSize(2, LE)] + 코드 (파일 끝까지)
+// 확장: Version 에 EXEC_VER_EXT 비트가 켜져 있으면 아래가 이어짐 (모두 LE)
+//   [4] hdr_size u8   [5] stack u8 (int 단위, 0=기본값)   [6] flags u8   [7] 0
+//   [8] code_size u16 [10] entry u16 (코드 오프셋)   [12] rodata_len u16   [14] 0 u16
+//   [16] crc32 u32 (code + rodata, StreamProtocol 과 같은 CRC-32)
+//   파일 = 헤더(hdr_size) + 코드(code_size) + rodata(rodata_len)
+#define EXEC_HEADER_SIZE 4
+#define EXEC_EXT_HEADER_SIZE 20
+#define EXEC_MAGIC     0xAD
+#define EXEC_VER_STACK 0x01         // v1: 스택 기반 바이트코드
+#define EXEC_VER_REG   0x02         // v2: 레지스터 기반 바이트코드
+#define EXEC_VER_EXT   0x80         // 확장 헤더 표시 비트 (하위 비트가 ISA)
+
+#define EXEC_FLAG_PRELOAD  0x01     // 코드 전체를 로드 시 RAM에 올림 (EXEC_PRELOAD_MAX 이하일 때)
+#define EXEC_FLAG_VERIFIED 0x02     // vmtools 가 stack 값을 정적 분석으로 증명함 (정보용, 런타임 검사는 유지)
+#define EXEC_PRELOAD_MAX   128      // PRELOAD 코드 버퍼 최대 크기 (bytes)
+#define EXEC_CACHE_SLOTS   2        // 웜 exec 캐시 칸 수 (칸당 약 80 bytes, ExecCache.h)
+#define BIN_INDEX_SLOTS    32       // /bin 해시 색인 칸 수 (2의 거듭제곱, 칸당 4 bytes)
+#define BIN_NEG_SLOTS      4        // 없는 명령 음성 캐시 칸 수 (칸당 13 bytes, 이름째 저장)
+#define DENTRY_SLOTS       8        // 경로 구성 요소 캐시 칸 수 (최대 127, 칸당 22 bytes)
+#define KFILE_SLOTS        4        // 커널 파일 핸들 풀 칸 수 (최대 8, 칸당 sizeof(File32))
+#define LS_CHUNK_BYTES     64       // 통신 데몬 ls 스트리밍 조각 크기 (통신 데몬 C 스택에 잡힘)
+#define LS_WINDOW          2        // ack 없이 먼저 보낼 수 있는 조각 수
+#define LS_ACK_TIMEOUT_MS  2000     // 이 시간 동안 ack 가 없으면 나열을 버리고 핸들 반납 (PC 연결 끊김 등)
+#define TASK_FDS           6        // 태스크별 fd 표 크기 (0~2 표준 입출력 포함, 칸당 1 byte)
+#define REDIR_BUF_SLOTS    1        // 리다이렉트 섹터 버퍼 수 (칸당 518 bytes, 8KB RAM 이라 하나만)
+#define REDIR_PREALLOC     8192UL   // 리다이렉트 대상이 빈 파일일 때 미리 잡는 연속 영역 (bytes)
+#define PIPE_SLOTS         2        // 파이프 수 (칸당 PIPE_SIZE + 4 bytes)
+#define PIPE_SIZE          64       // 파이프 링 크기 (bytes, 최대 255)
+#define MBOX_SLOTS         8        // 모든 태스크가 나눠 쓰는 메시지 칸 수 (칸당 5 + MBOX_WORDS*2 bytes)
+#define MBOX_WORDS         4        // 복사 메시지 최대 길이 (int, 더 크면 MALLOC 블록을 넘김)
+#define SHM_SLOTS          2        // 이름 있는 공유 세그먼트 수 (최대 8, 칸당 6 bytes + 인터닝 이름)
+#define SHM_VBASE          0x4000   // 공유 세그먼트 가상 주소 창 시작 (세그먼트 n = SHM_VBASE + n * GLOBAL_HEAP_SIZE)
+#define MMAP_SLOTS         2        // 파일 매핑 수 (태스크당 하나, 칸당 8 bytes)
+#ifndef MMAP_FRAMES
+#define MMAP_FRAMES        4        // 매핑 페이지 캐시 프레임 수 (프레임 내용은 매핑 중에만 전역 힙에서 빌림, 빌드 플래그로 변경)
+#endif                              // 프레임이 하나면 두 구간을 번갈아 건드릴 때마다 읽고 쓰므로 2개 이상 유지
+#ifndef MMAP_FRAME_SIZE
+#define MMAP_FRAME_SIZE    128      // 프레임 크기 (bytes, 섹터의 1/4: 같은 512 bytes 로 프레임 4개)
+#endif
+#define MMAP_VBASE         0x6000   // 매핑 창 가상 주소 시작 (창은 int 양수 끝까지, 한 칸에 한 바이트)
+#define MMAP_WINDOW        0x2000   // 매핑 창 최대 크기 (칸)
+#define SWAP_PATH          "/swap.sys" // 힙 스왑 파일 (부팅 시 TASK_COUNT * GLOBAL_HEAP_SIZE * 2 bytes 연속 할당)
+#define CKPT_DIR           "/ckpt"  // 부팅 자동 재개 대상 체크포인트 디렉터리
+#ifndef CKPT_AUTORESUME
+#define CKPT_AUTORESUME    0        // 1 이면 부팅 때 CKPT_DIR 의 체크포인트를 모두 되살림 (빌드 플래그로 변경)
+#endif
+#ifndef TMPFS_CELLS
+#define TMPFS_CELLS        128      // /tmp RAM 디스크 크기 (전역 힙 칸, 칸당 2 bytes, 0 이면 끔, 빌드 플래그로 변경)
+#endif
+#define TMPFS_BLOCK        32       // RAM 디스크 블록 크기 (bytes)
+#define TMPFS_FILES        4        // RAM 디스크 파일 수 (칸당 15 bytes)
+#define TMPFS_HANDLES      4        // RAM 디스크 열린 파일/디렉터리 커서 수 (칸당 5 bytes)
+
+// --- 프로파일러 ---
+#define PROF_SLOTS 64               // (task, pc) 히스토그램 칸 수 (2의 거듭제곱)
+#define PROF_DEFAULT_INTERVAL 1     // 기본 샘플 주기 (ms, Timer1 틱 단위)
+
+// --- 이벤트 트레이스 ---
+#ifndef ENABLE_TRACE
+#define ENABLE_TRACE 0              // 1 이면 커널 이벤트 기록 (링 버퍼 TRACE_BUFFER_SIZE * 8 bytes, 빌드 플래그 -D ENABLE_TRACE=1)
+#endif                              // 0 이면 TRACE() 호출이 컴파일에서 완전히 제거됨
+#define TRACE_BUFFER_SIZE 32        // 링 버퍼 이벤트 수 (2의 거듭제곱, 이벤트당 8바이트, 드레인 한 번이 HAL 송신 버퍼에 들어가야 하므로 최대 32)
 
 // --- 표준 스트림 ID ---
 #define FD_STDIN  0
@@ -25,6 +99,7 @@ enum VMOpcode : uint8_t {
   OP_PRTC   = 0x03, // 문자 출력
   OP_PRTE   = 0x04, // 에러 출력
   OP_PRTS   = 0x05, // [신규] 문자열 출력 (NULL 종료)
+  OP_PRTR   = 0x06, // [imm16 off] rodata 문자열 출력 (코드 파일에서 바로, NULL 종료)
 
   // 연산
   OP_PUSH   = 0x10,
@@ -40,6 +115,7 @@ enum VMOpcode : uint8_t {
   
   // 시스템
   OP_SYS    = 0x30,
+  OP_NATIVE = 0x31, // [imm16 id] 네이티브 함수 호출 (Native.cpp)
   
   // 하드웨어 제어
   OP_PIN_MODE = 0x40,
@@ -49,7 +125,60 @@ enum VMOpcode : uint8_t {
   //동적 메모리 관리
   OP_MALLOC = 0x50, // 메모리 할당 요청
   OP_LOAD   = 0x51, // 힙에서 읽기 (주소 기반)
-  OP_STORE  = 0x52  // 힙에 쓰기 (주소 기반)
+  OP_STORE  = 0x52, // 힙에 쓰기 (주소 기반)
+  OP_RCOPY  = 0x53, // [imm16 off] [dst, len] -> []   heap[dst+i] = rodata[off+i] (바이트)
+
+  // 배열 연산 (힙 범위 [addr, addr+len) 를 C++ 루프로 일괄 처리)
+  OP_ASUM   = 0x60, // [addr, len]            -> [sum]
+  OP_AMIN   = 0x61, // [addr, len]            -> [min, argmin]
+  OP_AMAX   = 0x62, // [addr, len]            -> [max, argmax]
+  OP_AADDS  = 0x63, // [addr, len, k]         -> []   a[i] += k
+  OP_AMULS  = 0x64, // [addr, len, k]         -> []   a[i] *= k
+  OP_AADD   = 0x65, // [dst, src, len]        -> []   dst[i] += src[i]
+  OP_ADOT   = 0x66, // [a, b, len]            -> [dot]
+  OP_AHIST  = 0x67, // [src, len, dst, bins, lo, width] -> []
+  OP_ACRC   = 0x68  // [addr, len]            -> [crc_lo, crc_hi]
+};
+
+// --- v2 명령어표 (레지스터 기반, 3-주소) ---
+// 인코딩 (R = [rX<<4 | rY] 1바이트, imm = 2바이트 LE)
+//   N  : [op]
+//   R  : [op][R]
+//   RR : [op][rd<<4|ra][rb]
+//   RI : [op][rd<<4|ra][imm]
+//   I  : [op][imm]
+// 시스템 콜 인자는 v1과 같이 태스크 스택으로 전달합니다. (RPUSH/RPOP)
+enum VMRegOpcode : uint8_t {
+  ROP_EXIT  = 0x00, // N
+  ROP_PRINT = 0x01, // R   print ra
+  ROP_READ  = 0x02, // R   rd = read()
+  ROP_PRTC  = 0x03, // R   putc ra
+  ROP_PRTE  = 0x04, // R   print(stderr) ra
+  ROP_PRTS  = 0x05, // R   puts heap[ra..]
+  ROP_PRTR  = 0x06, // I   puts rodata[imm..]
+
+  ROP_MOVI  = 0x10, // RI  rd = imm
+  ROP_MOV   = 0x11, // R   rd = ra
+  ROP_ADD   = 0x12, // RR  rd = ra + rb
+  ROP_SUB   = 0x13, // RR  rd = ra - rb
+  ROP_EQ    = 0x14, // RR  rd = (ra == rb)
+  ROP_ADDI  = 0x15, // RI  rd = ra + imm
+  ROP_PUSH  = 0x16, // R   stack <- ra
+  ROP_POP   = 0x17, // R   rd <- stack
+
+  ROP_JMP   = 0x20, // I   goto imm
+  ROP_JNZ   = 0x21, // RI  if (ra != 0) goto imm
+  ROP_JZ    = 0x22, // RI  if (ra == 0) goto imm
+
+  ROP_SYS   = 0x30, // I   syscall imm
+  ROP_NATIVE = 0x31, // I  native imm (인자/결과는 태스크 스택)
+
+  ROP_SLEEP = 0x42, // R   sleep ra ms
+
+  ROP_MALLOC = 0x50, // R  rd = malloc(ra)
+  ROP_LOAD   = 0x51, // RI rd = heap[ra + imm]
+  ROP_STORE  = 0x52, // RI heap[ra + imm] = rd
+  ROP_RCOPY  = 0x53  // RI heap[rd + i] = rodata[imm + i], i < ra
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,176 @@
+#include "Pipe.h"
+#include "Kernel.h"
+#include "KFile.h"
+
+struct Pipe {
+  uint8_t buf[PIPE_SIZE];
+  uint8_t head;     // 다음에 읽을 위치
+  uint8_t count;    // 들어 있는 바이트 수
+  uint8_t readers;  // 읽는 쪽 참조 수
+  uint8_t writers;  // 쓰는 쪽 참조 수
+};
+
+static_assert(PIPE_SIZE <= 255, "pipe ring indices are uint8_t");
+
+static Pipe pipes[PIPE_SLOTS];
+
+// 표준 출력 묶음: 같은 태스크의 같은 명령(instructions 카운터)이 쓴 출력
+static int8_t   txn_pipe = -1;
+static uint8_t  txn_task;
+static uint32_t txn_instr;
+static uint8_t  txn_len;   // 이번 실행이 링에 넣은 바이트 (막히면 되돌림)
+static uint16_t txn_pos;   // 이번 실행에서 명령이 낸 출력 위치
+static uint16_t txn_done;  // 앞선 실행이 이미 넘긴 바이트 (재실행 때 건너뜀)
+static bool     txn_retry; // 막혀서 재실행을 기다림 -> 같은 태스크의 다음 쓰기가 재실행
+
+void Pipe_init() {
+  memset(pipes, 0, sizeof(pipes));
+  txn_pipe = -1;
+}
+
+static Pipe* Pipe_of(int8_t v) {
+  int8_t p = (v - PIPE_FD_BASE) >> 1;
+  return (p >= 0 && p < PIPE_SLOTS) ? &pipes[p] : NULL;
+}
+
+int8_t Pipe_create(int8_t* read_end, int8_t* write_end) {
+  for (int8_t p = 0; p < PIPE_SLOTS; p++) {
+    Pipe* pp = &pipes[p];
+    if (pp->readers != 0 || pp->writers != 0) continue;
+    pp->head = 0;
+    pp->count = 0;
+    pp->readers = 1;
+    pp->writers = 1;
+    *read_end = PIPE_FD_BASE + (p << 1) + PIPE_READ;
+    *write_end = PIPE_FD_BASE + (p << 1) + PIPE_WRITE;
+    return p;
+  }
+  return -1;
+}
+
+void Pipe_ref(int8_t v) {
+  Pipe* pp = Pipe_of(v);
+  if (pp == NULL) return;
+  if (Pipe_endOf(v) == PIPE_READ) pp->readers++;
+  else pp->writers++;
+}
+
+void Pipe_unref(int8_t v) {
+  Pipe* pp = Pipe_of(v);
+  if (pp == NULL) return;
+  uint8_t* refs = (Pipe_endOf(v) == PIPE_READ) ? &pp->readers : &pp->writers;
+  if (*refs > 0 && --*refs == 0) Kernel_wakeBlocked(); // EOF / 읽는 쪽 사라짐 알림
+}
+
+void Pipe_releaseTask(Task* t) {
+  if (txn_pipe != -1 && txn_task == t->id) txn_pipe = -1; // 재실행 대기 중 종료
+  for (int fd = 0; fd < TASK_FDS; fd++) {
+    if (Pipe_isEnd(t->fds[fd])) {
+      Pipe_unref(t->fds[fd]);
+      t->fds[fd] = KFILE_NONE;
+    }
+  }
+}
+
+static void Pipe_push(Pipe* pp, const uint8_t* src, uint8_t n) {
+  uint8_t tail = (pp->head + pp->count) % PIPE_SIZE;
+  for (uint8_t i = 0; i < n; i++) {
+    pp->buf[tail] = src[i];
+    if (++tail == PIPE_SIZE) tail = 0;
+  }
+  pp->count += n;
+}
+
+int Pipe_read(Task* t, int8_t v, int* dst, int len) {
+  Pipe* pp = Pipe_of(v);
+  if (pp == NULL || Pipe_endOf(v) != PIPE_READ) return -1;
+  if (pp->count == 0) {
+    if (pp->writers == 0) return 0; // EOF
+    Kernel_block(t);
+    return PIPE_BLOCK;
+  }
+
+  int n = (len < pp->count) ? len : pp->count;
+  for (int i = 0; i < n; i++) {
+    dst[i] = pp->buf[pp->head];
+    if (++pp->head == PIPE_SIZE) pp->head = 0;
+  }
+  pp->count -= n;
+  if (txn_pipe == (int8_t)(pp - pipes) && !txn_retry) txn_pipe = -1; // 읽혀 나간 묶음은 되돌릴 수 없음
+  Kernel_wakeBlocked(); // 자리 생김
+  return n;
+}
+
+int Pipe_write(Task* t, int8_t v, const int* src, int len) {
+  Pipe* pp = Pipe_of(v);
+  if (pp == NULL || Pipe_endOf(v) != PIPE_WRITE || pp->readers == 0) return -1;
+
+  int space = PIPE_SIZE - pp->count;
+  int need = (len <= PIPE_SIZE) ? len : 1;
+  if (space < need) {
+    Kernel_block(t);
+    return PIPE_BLOCK;
+  }
+  int n = (len < space) ? len : space;
+  uint8_t tail = (pp->head + pp->count) % PIPE_SIZE;
+  for (int i = 0; i < n; i++) {
+    pp->buf[tail] = (uint8_t)src[i];
+    if (++tail == PIPE_SIZE) tail = 0;
+  }
+  pp->count += n;
+  Kernel_wakeBlocked(); // 데이터 생김
+  return n;
+}
+
+void Pipe_stdWrite(Task* t, int8_t v, const uint8_t* src, int len) {
+  if (t->task_state == TASK_BLOCKED) return; // 이 명령은 이미 막힘 (재실행 때 다시 씀)
+  Pipe* pp = Pipe_of(v);
+  if (pp == NULL || Pipe_endOf(v) != PIPE_WRITE || pp->readers == 0) return; // 읽는 쪽 없음: 버림
+
+  int8_t p = (int8_t)(pp - pipes);
+  if (txn_pipe == p && txn_task == t->id && txn_retry) {
+    // 막혔던 명령의 재실행: 출력을 처음부터 다시 내므로 앞서 넘긴 부분은 건너뜀
+    txn_retry = false;
+    txn_instr = t->stats.instructions;
+    txn_pos = 0;
+    txn_len = 0;
+  } else if (txn_pipe != p || txn_task != t->id || txn_instr != t->stats.instructions) {
+    txn_pipe = p;
+    txn_task = t->id;
+    txn_instr = t->stats.instructions;
+    txn_len = 0;
+    txn_pos = 0;
+    txn_done = 0;
+    txn_retry = false;
+  }
+
+  if (txn_pos < txn_done) {
+    int skip = txn_done - txn_pos;
+    if (skip > len) skip = len;
+    src += skip;
+    len -= skip;
+    txn_pos += skip;
+    if (len == 0) return;
+  }
+
+  int space = PIPE_SIZE - pp->count;
+  if (len > space) {
+    if (pp->count > txn_len) {
+      // 다른 데이터가 빠지면 자리가 생김: 이번 실행의 출력을 되돌리고 막힘
+      pp->count -= txn_len;
+    } else {
+      // 한 명령 출력이 링보다 큼: 들어가는 만큼 넘기고 막힘 (읽혀 나가면 재실행에서 나머지부터)
+      Pipe_push(pp, src, (uint8_t)space);
+      txn_done = txn_pos + space;
+      Kernel_wakeBlocked();
+    }
+    txn_len = 0;
+    txn_retry = true;
+    Kernel_block(t);
+    return;
+  }
+  Pipe_push(pp, src, (uint8_t)len);
+  txn_len += len;
+  txn_pos += len;
+  Kernel_wakeBlocked();
+}
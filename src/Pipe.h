@@ -0,0 +1,41 @@
+#ifndef PIPE_H
+#define PIPE_H
+
+#include "Task.h"
+
+// -----------------------------------------------------------------
+// [파이프]
+// 커널 메모리의 고정 크기 바이트 링 (PIPE_SLOTS 개 x PIPE_SIZE bytes).
+// 파이프 끝은 태스크 fd 표(Task::fds)에 PIPE_FD_BASE 이상 값으로 들어가며
+// 끝마다 참조 수(읽는 쪽/쓰는 쪽)를 셉니다. 양쪽 참조가 모두 0 이 되면 반납됩니다.
+//
+// 막힘: 비었는데 쓰는 쪽이 남아 있으면 읽기가, 가득 찼으면 쓰기가 태스크를 TASK_BLOCKED 로 만들고
+// VM 은 그 명령을 되감아 깨어난 뒤 다시 실행합니다 (링 상태가 바뀌면 막힌 태스크를 모두 깨움).
+// -----------------------------------------------------------------
+
+#define PIPE_FD_BASE 32   // fds[] 값 = PIPE_FD_BASE + 파이프 번호 * 2 + 끝
+#define PIPE_READ    0
+#define PIPE_WRITE   1
+
+#define PIPE_BLOCK   -2   // Pipe_read/Pipe_write: 막힘 (명령 재시도)
+
+inline bool Pipe_isEnd(int8_t v) { return v >= PIPE_FD_BASE; }
+inline uint8_t Pipe_endOf(int8_t v) { return (v - PIPE_FD_BASE) & 1; }
+
+void    Pipe_init();
+int8_t  Pipe_create(int8_t* read_end, int8_t* write_end); // 빈 파이프 확보 (끝 참조는 각 1), 없으면 -1
+void    Pipe_ref(int8_t v);          // 끝 참조 +1 (exec 으로 자식에게 넘길 때)
+void    Pipe_unref(int8_t v);        // 끝 참조 -1 (close / 태스크 종료)
+void    Pipe_releaseTask(Task* t);   // 태스크 fd 표의 파이프 끝을 모두 닫음
+
+// 읽기: 읽은 수 (1 이상), 0 = EOF (쓰는 쪽 없음), -1 = 읽는 끝이 아님, PIPE_BLOCK
+int     Pipe_read(Task* t, int8_t v, int* dst, int len);
+// 쓰기 (SYS write, 힙 셀의 하위 8비트): 쓴 수, -1 = 읽는 쪽 없음, PIPE_BLOCK
+//   len <= PIPE_SIZE 면 전부 들어갈 자리가 생길 때까지 막힘, 더 길면 들어가는 만큼만 씀
+int     Pipe_write(Task* t, int8_t v, const int* src, int len);
+// 표준 출력 명령(PRINT/PRTS/PRTR 등)용 쓰기: 한 명령의 출력 전체를 하나의 묶음으로 다룸
+//   자리가 모자라면 이번 명령에서 쓴 부분까지 되돌리고 막힘 -> 재실행 시 중복 출력 없음
+//   링보다 큰 출력은 들어가는 만큼씩 넘기고 막히며, 재실행은 이미 넘긴 부분을 건너뜀 (버리는 바이트 없음)
+void    Pipe_stdWrite(Task* t, int8_t v, const uint8_t* src, int len);
+
+#endif
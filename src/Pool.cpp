@@ -0,0 +1,80 @@
+#include "Pool.h"
+#include "Kernel.h"
+
+// 바이트 -> 전역 힙 칸 수 (칸 = int)
+#define POOL_CELLS(bytes) (((bytes) + sizeof(int) - 1) / sizeof(int))
+
+static uint16_t pool_used = 0; // 빌려 간 바이트 (칸 단위로 올림)
+static uint16_t pool_peak = 0; // pool_used 최댓값
+
+// 인터닝 테이블
+static const char* pool_strs[POOL_STR_SLOTS];
+static uint8_t pool_str_refs[POOL_STR_SLOTS];
+static const char pool_empty[] = "";
+
+void Pool_init() {
+  memset(pool_strs, 0, sizeof(pool_strs));
+  memset(pool_str_refs, 0, sizeof(pool_str_refs));
+  pool_used = 0;
+  pool_peak = 0;
+}
+
+// 전역 힙 first-fit (자리가 없으면 Kernel_allocCells 가 쉬는 태스크를 스왑으로 내보냄)
+void* Pool_alloc(uint16_t bytes) {
+  if (bytes == 0) return NULL;
+  int cells = POOL_CELLS(bytes);
+  int start = Kernel_allocCells(cells);
+  if (start == -1) return NULL;
+  pool_used += cells * sizeof(int);
+  if (pool_used > pool_peak) pool_peak = pool_used;
+  return &global_heap[start];
+}
+
+void Pool_free(void* ptr, uint16_t bytes) {
+  if (ptr == NULL || bytes == 0) return;
+  int start = (int*)ptr - global_heap;
+  int cells = POOL_CELLS(bytes);
+  if (start < 0 || start + cells > GLOBAL_HEAP_SIZE) return;
+  Kernel_freeCells(start, cells);
+  pool_used -= cells * sizeof(int);
+}
+
+uint16_t Pool_usedBytes() { return pool_used; }
+uint16_t Pool_peakBytes() { return pool_peak; }
+
+const char* Pool_intern(const char* s) {
+  if (s == NULL || s[0] == '\0') return pool_empty;
+
+  int free_slot = -1;
+  for (int i = 0; i < POOL_STR_SLOTS; i++) {
+    if (pool_strs[i] == NULL) {
+      if (free_slot == -1) free_slot = i;
+    } else if (pool_str_refs[i] < 255 && strcmp(pool_strs[i], s) == 0) {
+      pool_str_refs[i]++;
+      return pool_strs[i];
+    }
+  }
+  if (free_slot == -1) return NULL;
+
+  uint16_t size = strlen(s) + 1;
+  char* p = (char*)Pool_alloc(size);
+  if (p == NULL) return NULL;
+  memcpy(p, s, size);
+
+  pool_strs[free_slot] = p;
+  pool_str_refs[free_slot] = 1;
+  return p;
+}
+
+void Pool_release(const char* s) {
+  if (s == NULL || s == pool_empty) return;
+  for (int i = 0; i < POOL_STR_SLOTS; i++) {
+    if (pool_strs[i] == s) {
+      if (--pool_str_refs[i] == 0) {
+        Pool_free((void*)s, strlen(s) + 1);
+        pool_strs[i] = NULL;
+      }
+      return;
+    }
+  }
+}
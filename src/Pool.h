@@ -0,0 +1,26 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include "OSConfig.h"
+
+// -----------------------------------------------------------------
+// [Kernel Pool]
+// TCB(hot 부분)와 cold 부분(파일 핸들/코드 버퍼, VM 스택, cwd/경로 문자열)을
+// exec 시점에 잘라 주는 커널 객체 할당기입니다.
+// 별도 정적 영역 없이 전역 힙에서 소유 태스크 없는 칸(Kernel_allocCells)을 빌리므로
+// 쓰지 않는 슬롯은 SRAM 을 차지하지 않습니다. (단위: int 한 칸)
+// -----------------------------------------------------------------
+
+void  Pool_init();
+void* Pool_alloc(uint16_t bytes);         // 실패 시 NULL
+void  Pool_free(void* ptr, uint16_t bytes);
+
+uint16_t Pool_usedBytes();
+uint16_t Pool_peakBytes();
+
+// [문자열 인터닝] 같은 내용은 한 번만 저장하고 참조 카운트로 공유합니다.
+// (자식 태스크의 cwd 상속 등) 빈 문자열은 풀을 쓰지 않습니다.
+const char* Pool_intern(const char* s);   // 실패 시 NULL
+void Pool_release(const char* s);
+
+#endif
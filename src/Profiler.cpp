@@ -0,0 +1,132 @@
+#include "Profiler.h"
+#include "Kernel.h"
+#include "HAL.h"
+
+// --- 히스토그램 ---
+struct ProfSlot {
+  uint8_t  task;
+  uint16_t pc;
+  uint16_t count; // 0xFFFF 에서 포화
+};
+
+static ProfSlot prof_slots[PROF_SLOTS];
+static volatile bool prof_enabled = false;
+static uint8_t prof_interval = PROF_DEFAULT_INTERVAL;
+static uint8_t prof_countdown = 0;
+static uint32_t prof_samples = 0; // 전체 샘플 수
+static uint16_t prof_dropped = 0; // 칸이 없어 버려진 샘플 수
+
+#define PROF_MAX_PROBE 4
+
+void Profiler_start(uint8_t interval_ms) {
+  noInterrupts();
+  memset(prof_slots, 0, sizeof(prof_slots));
+  prof_interval = (interval_ms == 0) ? 1 : interval_ms;
+  prof_countdown = prof_interval;
+  prof_samples = 0;
+  prof_dropped = 0;
+  prof_enabled = true;
+  interrupts();
+}
+
+void Profiler_stop() {
+  prof_enabled = false;
+}
+
+// ISR 컨텍스트: 짧게 유지 (최대 PROF_MAX_PROBE 번 탐색)
+void Profiler_tick() {
+  if (!prof_enabled) return;
+  if (--prof_countdown != 0) return;
+  prof_countdown = prof_interval;
+
+  uint8_t task;
+  uint16_t pc = 0;
+  int8_t cur = kernel_current_task;
+  if (cur < 0) {
+    task = PROF_TASK_IDLE;
+  } else {
+    task = (uint8_t)cur;
+    if (cur != 0) {
+      // 메인 루프가 갱신 중일 수 있으나 샘플링 용도로는 충분함
+      const Task* t = tasks[cur];
+      pc = t->codePc();
+    }
+  }
+
+  prof_samples++;
+  uint8_t h = (uint8_t)((pc ^ (pc >> 6) ^ (task << 3)) & (PROF_SLOTS - 1));
+  for (uint8_t probe = 0; probe < PROF_MAX_PROBE; probe++) {
+    ProfSlot* s = &prof_slots[(h + probe) & (PROF_SLOTS - 1)];
+    if (s->count == 0) {
+      s->task = task;
+      s->pc = pc;
+      s->count = 1;
+      return;
+    }
+    if (s->task == task && s->pc == pc) {
+      if (s->count != 0xFFFF) s->count++;
+      return;
+    }
+  }
+  prof_dropped++;
+}
+
+// 덤프 형식 (PT_BYTES, LE)
+//   [enabled u8][interval u8][samples u32][dropped u16][n u16]
+//   n x [task u8][pc u16][count u16]
+// HAL 송신 버퍼에 바로 씀 (별도 정적 버퍼 없음)
+static_assert(10 + PROF_SLOTS * 5 <= HAL_TX_PAYLOAD_MAX, "PROF_SLOTS: 덤프가 HAL 송신 버퍼를 넘음");
+
+void Profiler_dump() {
+  uint8_t* out = HAL_txPayload();
+  uint16_t n = 0;
+  uint8_t* p = out + 10;
+
+  noInterrupts();
+  for (int i = 0; i < PROF_SLOTS; i++) {
+    if (prof_slots[i].count == 0) continue;
+    p[0] = prof_slots[i].task;
+    p[1] = (uint8_t)(prof_slots[i].pc & 0xFF);
+    p[2] = (uint8_t)(prof_slots[i].pc >> 8);
+    p[3] = (uint8_t)(prof_slots[i].count & 0xFF);
+    p[4] = (uint8_t)(prof_slots[i].count >> 8);
+    p += 5;
+    n++;
+  }
+  uint32_t samples = prof_samples;
+  uint16_t dropped = prof_dropped;
+  interrupts();
+
+  out[0] = prof_enabled ? 1 : 0;
+  out[1] = prof_interval;
+  for (int i = 0; i < 4; i++) out[2 + i] = (uint8_t)(samples >> (8 * i));
+  out[6] = (uint8_t)(dropped & 0xFF);
+  out[7] = (uint8_t)(dropped >> 8);
+  out[8] = (uint8_t)(n & 0xFF);
+  out[9] = (uint8_t)(n >> 8);
+
+  HAL_sendTxPayload(CMD_PROF, PT_BYTES, (uint32_t)(p - out));
+}
+
+// 요청 (PT_STRING): "start [interval_ms]" | "stop" | "dump"
+void Profiler_command(const uint8_t* payload, int len) {
+  char cmd[16];
+  if (len > 15) len = 15;
+  memcpy(cmd, payload, len);
+  cmd[len] = 0;
+
+  if (strncmp(cmd, "start", 5) == 0) {
+    int interval = (len > 6) ? atoi(cmd + 6) : PROF_DEFAULT_INTERVAL;
+    if (interval < 1) interval = 1;
+    if (interval > 255) interval = 255;
+    Profiler_start((uint8_t)interval);
+    HAL_write(FD_STDOUT, "Profiler started.\n");
+  } else if (strcmp(cmd, "stop") == 0) {
+    Profiler_stop();
+    HAL_write(FD_STDOUT, "Profiler stopped.\n");
+  } else if (strcmp(cmd, "dump") == 0) {
+    Profiler_dump();
+  } else {
+    HAL_write(FD_STDERR, "Usage: prof start [ms] | stop | dump\n");
+  }
+}
@@ -0,0 +1,26 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdint.h>
+
+// -----------------------------------------------------------------
+// [Sampling Profiler]
+// Timer1 ISR(1ms)이 interval 틱마다 "현재 태스크 + 코드 오프셋"을 샘플링하여
+// 고정 크기 (task, pc) 히스토그램에 누적합니다.
+//
+// pc 는 "다음에 fetch 할 코드 오프셋"(헤더 제외)입니다.
+// vmtools.py prof 는 이를 (pc - 1) 을 포함하는 명령어에 귀속시킵니다.
+//
+// 특수 task 값: 0 = 통신 데몬(C++), PROF_TASK_IDLE = 실행 중인 태스크 없음
+// -----------------------------------------------------------------
+#define PROF_TASK_IDLE 0xFF
+
+void Profiler_start(uint8_t interval_ms); // 히스토그램 초기화 후 샘플링 시작
+void Profiler_stop();
+void Profiler_dump();                     // CMD_PROF 바이너리 패킷으로 전송
+void Profiler_command(const uint8_t* payload, int len); // CMD_PROF 요청 처리
+
+// Timer1 ISR 에서 매 틱 호출 (비활성 시 즉시 리턴)
+void Profiler_tick();
+
+#endif
@@ -18,11 +18,31 @@
 #define SYS_EXEC        2
 #define SYS_CHDIR       3
 #define SYS_GETCWD      4
+#define SYS_OPENDIR     10
+#define SYS_READDIR     11
+#define SYS_CLOSEDIR    12
+#define SYS_OPEN        20
+#define SYS_READ        21
+#define SYS_WRITE       22
+#define SYS_SEEK        23
+#define SYS_CLOSE       24
+#define SYS_UNLINK      25
+#define SYS_PIPE        30
+#define SYS_SEND        40
+#define SYS_RECV        41
+#define SYS_SENDBLK     42
+#define SYS_SHMGET      45
+#define SYS_SHMDT       46
 
 // [100 ~ ] Special Commands
 #define CMD_STDIN       100 // PC -> Arduino: 키보드 입력
 #define CMD_STDOUT      101 // Arduino -> PC: 화면 출력
 #define CMD_STDERR      102 // Arduino -> PC: 에러 출력
+#define CMD_PROF        110 // 프로파일러 (PC -> "start [ms]"/"stop"/"dump", Arduino -> 덤프 PT_BYTES)
+#define CMD_TRACE       111 // 트레이스 (PC -> "mask <hex>"/"drain", Arduino -> 이벤트 PT_BYTES)
+#define CMD_STATS       112 // 통계 스냅샷 (PC -> 요청, Arduino -> PT_BYTES)
+#define CMD_MEMINFO     113 // 메모리/스택 사용량 (PC -> 요청, Arduino -> PT_BYTES)
+#define CMD_LIST        114 // ls 스트리밍 (Arduino -> 조각 PT_STRING, 빈 조각 = 끝 / PC -> 조각마다 ack)
 #define CMD_PING        200 // 생존 확인
 #define CMD_PONG        201 // 응답
 
@@ -0,0 +1,102 @@
+#include "Redirect.h"
+#include "Kernel.h"
+#include "KFile.h"
+
+#define REDIR_SECTOR 512
+
+struct RedirBuf {
+  int8_t owner;     // 태스크 id (-1 = 빈 칸)
+  int8_t fd;
+  uint16_t fill;
+  uint16_t cap;     // 이번 플러시까지 채울 양 (이어 쓰기 첫 회는 섹터 경계까지)
+  uint8_t data[REDIR_SECTOR];
+};
+
+static RedirBuf redir_bufs[REDIR_BUF_SLOTS];
+
+void Redirect_init() {
+  for (int i = 0; i < REDIR_BUF_SLOTS; i++) redir_bufs[i].owner = -1;
+}
+
+static RedirBuf* Redirect_bufferOf(Task* t, int fd) {
+  for (int i = 0; i < REDIR_BUF_SLOTS; i++) {
+    if (redir_bufs[i].owner == t->id && redir_bufs[i].fd == fd) return &redir_bufs[i];
+  }
+  return NULL;
+}
+
+static void Redirect_flush(RedirBuf* b, File32* f) {
+  if (b->fill > 0) f->write(b->data, b->fill);
+  b->fill = 0;
+  b->cap = REDIR_SECTOR; // 이후로는 섹터 경계에 정렬됨
+}
+
+bool Redirect_open(Task* t, int fd, const char* abs_path, bool append) {
+  if (fd != FD_STDOUT && fd != FD_STDERR) return false;
+  Redirect_close(t, fd);
+
+  int8_t h = KFile_alloc(t->id);
+  File32* f = KFile_get(h, t->id);
+  // 이어 쓰기도 O_APPEND 없이 엶: 선할당이 fileSize 를 늘리므로 O_APPEND 면 그 뒤에 쓰게 됨
+  // (이 핸들은 리다이렉트만 쓰므로 처음 끝 위치에서 차례로 쓰면 이어 쓰기와 같음)
+  oflag_t oflag = O_WRONLY | O_CREAT | (append ? 0 : O_TRUNC);
+  if (f == NULL || !Kernel_openFile(abs_path, oflag, f)) {
+    KFile_free(h);
+    return false;
+  }
+
+  // 빈 파일이면 연속 클러스터를 미리 잡아 둠 (실패해도 그냥 진행, 종료 시 남은 부분 반납)
+  uint32_t end = f->fileSize();
+  if (end == 0) f->preAllocate(REDIR_PREALLOC);
+  f->seekSet(end);
+  t->fds[fd] = h;
+
+  for (int i = 0; i < REDIR_BUF_SLOTS; i++) {
+    RedirBuf* b = &redir_bufs[i];
+    if (b->owner != -1) continue;
+    b->owner = t->id;
+    b->fd = fd;
+    b->fill = 0;
+    b->cap = REDIR_SECTOR - (f->curPosition() % REDIR_SECTOR);
+    break;
+  }
+  return true;
+}
+
+bool Redirect_write(Task* t, int fd, const uint8_t* data, uint16_t len) {
+  if (fd != FD_STDOUT && fd != FD_STDERR) return false;
+  File32* f = KFile_get(t->fds[fd], t->id);
+  if (f == NULL) return false;
+
+  RedirBuf* b = Redirect_bufferOf(t, fd);
+  if (b == NULL) {
+    f->write(data, len);
+    return true;
+  }
+  while (len > 0) {
+    uint16_t n = b->cap - b->fill;
+    if (n > len) n = len;
+    memcpy(b->data + b->fill, data, n);
+    b->fill += n;
+    data += n;
+    len -= n;
+    if (b->fill == b->cap) Redirect_flush(b, f);
+  }
+  return true;
+}
+
+bool Redirect_close(Task* t, int fd) {
+  if (fd != FD_STDOUT && fd != FD_STDERR) return false;
+  File32* f = KFile_get(t->fds[fd], t->id);
+  if (f == NULL) return false;
+
+  RedirBuf* b = Redirect_bufferOf(t, fd);
+  if (b != NULL) {
+    Redirect_flush(b, f);
+    b->owner = -1;
+  }
+  f->truncate(); // 현재 위치 뒤의 선할당 클러스터 반납
+  KFile_free(t->fds[fd]); // close = 최종 sync
+  t->fds[fd] = KFILE_NONE;
+  return true;
+}
@@ -0,0 +1,19 @@
+#ifndef REDIRECT_H
+#define REDIRECT_H
+
+#include "Task.h"
+
+// -----------------------------------------------------------------
+// [표준 출력/에러 리다이렉트]
+// exec 의 "> 파일", ">> 파일", "2> 파일" 로 자식의 fd 1/2 를 SD 파일에 연결합니다.
+// 파일은 커널 파일 핸들 풀(KFile)에 열리고 Task::fds[1/2] 에 기록됩니다.
+// 섹터 버퍼(REDIR_BUF_SLOTS 개)를 얻은 리다이렉트는 512 바이트 단위로 모아
+// 섹터 경계에 맞춰 기록하고, 버퍼가 모자라면 File32 에 바로 씁니다 (SdFat 블록 캐시).
+// -----------------------------------------------------------------
+
+void Redirect_init();
+bool Redirect_open(Task* t, int fd, const char* abs_path, bool append);
+bool Redirect_write(Task* t, int fd, const uint8_t* data, uint16_t len); // 리다이렉트가 아니면 false
+bool Redirect_close(Task* t, int fd);  // 버퍼 비우기 + 남은 선할당 반납 + 닫기 (리다이렉트가 아니면 false)
+
+#endif
@@ -0,0 +1,26 @@
+#include "Rom.h"
+
+bool Rom_entry(int8_t idx, RomEntry* out) {
+  if (idx < 0 || idx >= rom_count) return false;
+  memcpy_P(out, &rom_dir[idx], sizeof(RomEntry));
+  return true;
+}
+
+bool Rom_isPath(const char* abs_path) {
+  size_t n = strlen(ROM_MOUNT);
+  return strncmp(abs_path, ROM_MOUNT, n) == 0 && (abs_path[n] == '\0' || abs_path[n] == '/');
+}
+
+int8_t Rom_find(const char* name) {
+  // "/rom/ls" 는 마운트 부분을 떼고, 다른 경로 ("/bin/ls", "ls.bin") 는 ROM 대상이 아님
+  if (Rom_isPath(name)) {
+    name += strlen(ROM_MOUNT);
+    if (*name++ == '\0') return -1; // 마운트 자체
+  }
+  else if (strchr(name, '/') != NULL || strchr(name, '.') != NULL) return -1;
+
+  for (int8_t i = 0; i < rom_count; i++) {
+    if (strcmp_P(name, rom_dir[i].name) == 0) return i;
+  }
+  return -1;
+}
@@ -0,0 +1,37 @@
+#ifndef ROM_H
+#define ROM_H
+
+#include "OSConfig.h"
+#include <Arduino.h>
+
+// -----------------------------------------------------------------
+// [ROM 파일 시스템 - /rom]
+// 자주 쓰는 실행 파일을 펌웨어와 함께 플래시(PROGMEM)에 굽는 읽기 전용 이미지입니다.
+// 이미지와 목록은 vmtools.py rom 이 만든 RomImage.cpp 에 있습니다 (빌드 전 test/rom_pre.py 가 갱신).
+// Kernel_loadTask 는 SD 보다 먼저 여기서 찾고, 찾은 실행 파일은 코드 버퍼 없이
+// pgm_read_byte 로 바로 실행됩니다 (XIP, Task::code_buf_size == 0).
+// 이미지 오프셋은 16비트이므로 이미지는 64KB 이하 (pgm_read_byte 가 닿는 플래시 앞쪽에 놓임).
+// -----------------------------------------------------------------
+
+#define ROM_MOUNT    "/rom"
+#define ROM_NAME_MAX 12   // 이름 (NULL 포함)
+
+struct RomEntry {
+  char     name[ROM_NAME_MAX];
+  uint16_t offset;  // rom_image 안 파일 시작
+  uint16_t size;    // 파일 크기 (헤더 포함)
+};
+
+extern const uint8_t  rom_image[] PROGMEM;
+extern const RomEntry rom_dir[] PROGMEM;
+extern const uint8_t  rom_count;
+
+// 명령 이름 ("ls") 또는 "/rom/ls" -> 항목 번호, 없으면 -1
+int8_t Rom_find(const char* name);
+bool   Rom_entry(int8_t idx, RomEntry* out);   // 목록 항목 복사 (범위 밖이면 false)
+bool   Rom_isPath(const char* abs_path);       // ROM_MOUNT 자체 또는 그 아래
+
+inline uint8_t Rom_byte(uint16_t addr) { return pgm_read_byte(rom_image + addr); }
+inline void Rom_read(uint16_t addr, uint8_t* dst, int len) { memcpy_P(dst, rom_image + addr, len); }
+
+#endif
@@ -0,0 +1,80 @@
+// 자동 생성 파일 - 직접 고치지 마세요 (python vmtools.py rom <out.cpp> <파일>...)
+// shell(1034) ls(38)
+#include "Rom.h"
+
+const uint8_t rom_count = 2;
+
+const RomEntry rom_dir[] PROGMEM = {
+  {"shell", 0, 1034},
+  {"ls", 1034, 38},
+};
+
+const uint8_t rom_image[] PROGMEM = {
+  0xAD, 0x81, 0x00, 0x01, 0x14, 0x40, 0x00, 0x00, 0xF6, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0xA4, 0x9C, 0xC1, 0x5D, 0x10, 0x00, 0x00, 0x10, 0x00, 0x00, 0x52, 0x10, 0xC8, 0x00, 0x10, 0x04,
+  0x00, 0x30, 0x10, 0xC8, 0x00, 0x05, 0x10, 0x3E, 0x00, 0x03, 0x10, 0x20, 0x00, 0x03, 0x02, 0x14,
+  0x10, 0x00, 0x00, 0x13, 0x21, 0x4B, 0x00, 0x14, 0x10, 0x0D, 0x00, 0x13, 0x21, 0x4B, 0x00, 0x14,
+  0x10, 0x0A, 0x00, 0x13, 0x21, 0x4F, 0x00, 0x10, 0x00, 0x00, 0x51, 0x10, 0x01, 0x00, 0x11, 0x52,
+  0x10, 0x00, 0x00, 0x51, 0x10, 0x01, 0x00, 0x11, 0x10, 0x00, 0x00, 0x52, 0x20, 0x1A, 0x00, 0x15,
+  0x20, 0x1A, 0x00, 0x15, 0x10, 0x00, 0x00, 0x10, 0x00, 0x00, 0x51, 0x10, 0x01, 0x00, 0x11, 0x52,
+  0x10, 0x01, 0x00, 0x10, 0x40, 0x00, 0x52, 0x10, 0x40, 0x00, 0x51, 0x51, 0x14, 0x10, 0x00, 0x00,
+  0x13, 0x21, 0x9C, 0x00, 0x14, 0x10, 0x20, 0x00, 0x13, 0x21, 0x88, 0x00, 0x15, 0x10, 0x40, 0x00,
+  0x51, 0x10, 0x01, 0x00, 0x11, 0x10, 0x40, 0x00, 0x52, 0x20, 0x63, 0x00, 0x15, 0x10, 0x00, 0x00,
+  0x10, 0x40, 0x00, 0x51, 0x52, 0x10, 0x40, 0x00, 0x51, 0x10, 0x01, 0x00, 0x11, 0x20, 0xA0, 0x00,
+  0x15, 0x10, 0x00, 0x00, 0x10, 0x43, 0x00, 0x52, 0x10, 0x43, 0x00, 0x51, 0x10, 0x00, 0x00, 0x13,
+  0x21, 0xFE, 0x00, 0x10, 0x6E, 0x00, 0x10, 0x44, 0x00, 0x52, 0x10, 0x43, 0x00, 0x51, 0x10, 0x45,
+  0x00, 0x52, 0x10, 0x45, 0x00, 0x51, 0x51, 0x14, 0x10, 0x00, 0x00, 0x13, 0x21, 0xEB, 0x00, 0x10,
+  0x44, 0x00, 0x51, 0x52, 0x10, 0x44, 0x00, 0x51, 0x10, 0x01, 0x00, 0x11, 0x10, 0x44, 0x00, 0x52,
+  0x10, 0x45, 0x00, 0x51, 0x10, 0x01, 0x00, 0x11, 0x10, 0x45, 0x00, 0x52, 0x20, 0xBE, 0x00, 0x15,
+  0x10, 0x00, 0x00, 0x10, 0x44, 0x00, 0x51, 0x52, 0x10, 0x6E, 0x00, 0x10, 0x43, 0x00, 0x52, 0x20,
+  0x05, 0x01, 0x10, 0x00, 0x00, 0x10, 0x43, 0x00, 0x52, 0x10, 0x01, 0x00, 0x10, 0x42, 0x00, 0x52,
+  0x10, 0x42, 0x00, 0x51, 0x51, 0x10, 0x63, 0x00, 0x13, 0x21, 0x1B, 0x01, 0x20, 0x69, 0x01, 0x10,
+  0x42, 0x00, 0x51, 0x10, 0x01, 0x00, 0x11, 0x10, 0x42, 0x00, 0x52, 0x10, 0x42, 0x00, 0x51, 0x51,
+  0x10, 0x64, 0x00, 0x13, 0x21, 0x36, 0x01, 0x20, 0x69, 0x01, 0x10, 0x42, 0x00, 0x51, 0x10, 0x01,
+  0x00, 0x11, 0x10, 0x42, 0x00, 0x52, 0x10, 0x42, 0x00, 0x51, 0x51, 0x14, 0x10, 0x00, 0x00, 0x13,
+  0x21, 0x5B, 0x01, 0x14, 0x10, 0x20, 0x00, 0x13, 0x21, 0x5B, 0x01, 0x15, 0x20, 0x69, 0x01, 0x10,
+  0xC8, 0x00, 0x10, 0x43, 0x00, 0x51, 0x10, 0x03, 0x00, 0x30, 0x20, 0xB7, 0x03, 0x10, 0x01, 0x00,
+  0x10, 0x42, 0x00, 0x52, 0x10, 0x42, 0x00, 0x51, 0x51, 0x10, 0x65, 0x00, 0x13, 0x21, 0x7F, 0x01,
+  0x20, 0xF5, 0x01, 0x10, 0x42, 0x00, 0x51, 0x10, 0x01, 0x00, 0x11, 0x10, 0x42, 0x00, 0x52, 0x10,
+  0x42, 0x00, 0x51, 0x51, 0x10, 0x78, 0x00, 0x13, 0x21, 0x9A, 0x01, 0x20, 0xF5, 0x01, 0x10, 0x42,
+  0x00, 0x51, 0x10, 0x01, 0x00, 0x11, 0x10, 0x42, 0x00, 0x52, 0x10, 0x42, 0x00, 0x51, 0x51, 0x10,
+  0x65, 0x00, 0x13, 0x21, 0xB5, 0x01, 0x20, 0xF5, 0x01, 0x10, 0x42, 0x00, 0x51, 0x10, 0x01, 0x00,
+  0x11, 0x10, 0x42, 0x00, 0x52, 0x10, 0x42, 0x00, 0x51, 0x51, 0x10, 0x63, 0x00, 0x13, 0x21, 0xD0,
+  0x01, 0x20, 0xF5, 0x01, 0x10, 0x42, 0x00, 0x51, 0x10, 0x01, 0x00, 0x11, 0x10, 0x42, 0x00, 0x52,
+  0x10, 0x42, 0x00, 0x51, 0x51, 0x14, 0x10, 0x00, 0x00, 0x13, 0x21, 0xF8, 0x01, 0x14, 0x10, 0x20,
+  0x00, 0x13, 0x21, 0xF8, 0x01, 0x15, 0x20, 0xF5, 0x01, 0x20, 0xEF, 0x02, 0x15, 0x10, 0x01, 0x00,
+  0x10, 0x52, 0x00, 0x52, 0x10, 0x43, 0x00, 0x51, 0x10, 0x50, 0x00, 0x52, 0x10, 0x50, 0x00, 0x51,
+  0x10, 0x00, 0x00, 0x13, 0x21, 0xB7, 0x03, 0x10, 0x50, 0x00, 0x51, 0x51, 0x10, 0x2D, 0x00, 0x13,
+  0x21, 0x22, 0x02, 0x20, 0x66, 0x02, 0x10, 0x50, 0x00, 0x51, 0x10, 0x01, 0x00, 0x11, 0x51, 0x10,
+  0x62, 0x00, 0x13, 0x21, 0x35, 0x02, 0x20, 0x66, 0x02, 0x10, 0x00, 0x00, 0x10, 0x52, 0x00, 0x52,
+  0x10, 0x50, 0x00, 0x51, 0x10, 0x02, 0x00, 0x11, 0x10, 0x50, 0x00, 0x52, 0x10, 0x50, 0x00, 0x51,
+  0x51, 0x10, 0x20, 0x00, 0x13, 0x21, 0x57, 0x02, 0x20, 0x66, 0x02, 0x10, 0x50, 0x00, 0x51, 0x10,
+  0x01, 0x00, 0x11, 0x10, 0x50, 0x00, 0x52, 0x20, 0x48, 0x02, 0x10, 0x96, 0x00, 0x10, 0x51, 0x00,
+  0x52, 0x10, 0x50, 0x00, 0x51, 0x51, 0x14, 0x10, 0x00, 0x00, 0x13, 0x21, 0xCD, 0x02, 0x14, 0x10,
+  0x20, 0x00, 0x13, 0x21, 0xA2, 0x02, 0x10, 0x51, 0x00, 0x51, 0x52, 0x10, 0x50, 0x00, 0x51, 0x10,
+  0x01, 0x00, 0x11, 0x10, 0x50, 0x00, 0x52, 0x10, 0x51, 0x00, 0x51, 0x10, 0x01, 0x00, 0x11, 0x10,
+  0x51, 0x00, 0x52, 0x20, 0x6D, 0x02, 0x15, 0x10, 0x50, 0x00, 0x51, 0x10, 0x01, 0x00, 0x11, 0x10,
+  0x50, 0x00, 0x52, 0x10, 0x50, 0x00, 0x51, 0x51, 0x10, 0x20, 0x00, 0x13, 0x21, 0xBE, 0x02, 0x20,
+  0xD5, 0x02, 0x10, 0x50, 0x00, 0x51, 0x10, 0x01, 0x00, 0x11, 0x10, 0x50, 0x00, 0x52, 0x20, 0xAF,
+  0x02, 0x15, 0x10, 0x00, 0x00, 0x10, 0x50, 0x00, 0x52, 0x10, 0x00, 0x00, 0x10, 0x51, 0x00, 0x51,
+  0x52, 0x10, 0x50, 0x00, 0x51, 0x10, 0x96, 0x00, 0x10, 0x52, 0x00, 0x51, 0x10, 0x02, 0x00, 0x30,
+  0x20, 0xB7, 0x03, 0x10, 0x2F, 0x00, 0x10, 0x46, 0x00, 0x52, 0x10, 0x62, 0x00, 0x10, 0x47, 0x00,
+  0x52, 0x10, 0x69, 0x00, 0x10, 0x48, 0x00, 0x52, 0x10, 0x6E, 0x00, 0x10, 0x49, 0x00, 0x52, 0x10,
+  0x2F, 0x00, 0x10, 0x4A, 0x00, 0x52, 0x10, 0x4B, 0x00, 0x10, 0x41, 0x00, 0x52, 0x10, 0x01, 0x00,
+  0x10, 0x42, 0x00, 0x52, 0x10, 0x42, 0x00, 0x51, 0x51, 0x14, 0x10, 0x00, 0x00, 0x13, 0x21, 0x4D,
+  0x03, 0x10, 0x41, 0x00, 0x51, 0x52, 0x10, 0x41, 0x00, 0x51, 0x10, 0x01, 0x00, 0x11, 0x10, 0x41,
+  0x00, 0x52, 0x10, 0x42, 0x00, 0x51, 0x10, 0x01, 0x00, 0x11, 0x10, 0x42, 0x00, 0x52, 0x20, 0x20,
+  0x03, 0x15, 0x10, 0x2E, 0x00, 0x10, 0x41, 0x00, 0x51, 0x52, 0x10, 0x41, 0x00, 0x51, 0x10, 0x01,
+  0x00, 0x11, 0x10, 0x41, 0x00, 0x52, 0x10, 0x62, 0x00, 0x10, 0x41, 0x00, 0x51, 0x52, 0x10, 0x41,
+  0x00, 0x51, 0x10, 0x01, 0x00, 0x11, 0x10, 0x41, 0x00, 0x52, 0x10, 0x69, 0x00, 0x10, 0x41, 0x00,
+  0x51, 0x52, 0x10, 0x41, 0x00, 0x51, 0x10, 0x01, 0x00, 0x11, 0x10, 0x41, 0x00, 0x52, 0x10, 0x6E,
+  0x00, 0x10, 0x41, 0x00, 0x51, 0x52, 0x10, 0x41, 0x00, 0x51, 0x10, 0x01, 0x00, 0x11, 0x10, 0x41,
+  0x00, 0x52, 0x10, 0x00, 0x00, 0x10, 0x41, 0x00, 0x51, 0x52, 0x10, 0x43, 0x00, 0x51, 0x10, 0x46,
+  0x00, 0x10, 0x01, 0x00, 0x10, 0x02, 0x00, 0x30, 0x20, 0xB7, 0x03, 0x10, 0x01, 0x00, 0x10, 0x41,
+  0x00, 0x52, 0x10, 0x00, 0x00, 0x10, 0x41, 0x00, 0x51, 0x52, 0x10, 0x41, 0x00, 0x51, 0x10, 0x01,
+  0x00, 0x11, 0x10, 0x41, 0x00, 0x52, 0x10, 0x41, 0x00, 0x51, 0x10, 0x40, 0x00, 0x13, 0x21, 0xE0,
+  0x03, 0x20, 0xBE, 0x03, 0x10, 0x00, 0x00, 0x10, 0x00, 0x00, 0x52, 0x10, 0xC8, 0x00, 0x05, 0x10,
+  0x3E, 0x00, 0x03, 0x10, 0x20, 0x00, 0x03, 0x20, 0x1A, 0x00, 0xAD, 0x81, 0x20, 0x00, 0x14, 0x04,
+  0x02, 0x00, 0x12, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x77, 0x6B, 0x2E, 0xD2, 0x10, 0x01,
+  0x00, 0x10, 0x64, 0x00, 0x10, 0x00, 0x00, 0x10, 0x01, 0x00, 0x30, 0x10, 0x01, 0x00, 0x05, 0x00,
+};
@@ -0,0 +1,110 @@
+#include "Shm.h"
+#include "Kernel.h"
+#include "Pool.h"
+
+struct ShmSeg {
+  const char* name;  // 인터닝 (NULL = 빈 칸)
+  int base;          // 전역 힙 시작 인덱스
+  int size;          // 칸 수
+  uint8_t refs;      // 붙인 태스크 수
+};
+
+static ShmSeg segs[SHM_SLOTS];
+
+void Shm_init() {
+  memset(segs, 0, sizeof(segs));
+}
+
+static int Shm_vbase(int n) { return SHM_VBASE + n * GLOBAL_HEAP_SIZE; }
+
+static void Shm_unref(int n) {
+  ShmSeg* s = &segs[n];
+  if (s->refs > 0 && --s->refs == 0) {
+    Kernel_freeCells(s->base, s->size);
+    Pool_release(s->name);
+    s->name = NULL;
+  }
+}
+
+// 파일 내용을 세그먼트에 한 칸에 한 바이트씩 채움 (남는 칸은 0)
+static bool Shm_load(ShmSeg* s, const char* path) {
+  File32 f;
+  if (!Kernel_openFile(path, O_RDONLY, &f)) return false;
+  int i = 0;
+  uint8_t buf[32];
+  while (i < s->size) {
+    int want = s->size - i;
+    if (want > (int)sizeof(buf)) want = sizeof(buf);
+    int n = f.read(buf, want);
+    if (n <= 0) break;
+    for (int k = 0; k < n; k++) global_heap[s->base + i + k] = buf[k];
+    i += n;
+  }
+  f.close();
+  return true;
+}
+
+int Shm_attach(Task* t, const char* name, int size, const char* init_path) {
+  int empty = -1;
+  for (int n = 0; n < SHM_SLOTS; n++) {
+    ShmSeg* s = &segs[n];
+    if (s->name == NULL) {
+      if (empty == -1) empty = n;
+      continue;
+    }
+    if (strcmp(s->name, name) != 0) continue;
+
+    // 기존 세그먼트에 붙이기 (초기화는 이미 끝남)
+    if (size > s->size) return -1;
+    if ((t->shm_mask & (1 << n)) == 0) {
+      t->shm_mask |= (1 << n);
+      s->refs++;
+    }
+    return Shm_vbase(n);
+  }
+
+  if (empty == -1 || size <= 0 || size > GLOBAL_HEAP_SIZE) return -1;
+  ShmSeg* s = &segs[empty];
+  s->base = Kernel_allocCells(size);
+  if (s->base == -1) return -1;
+  s->name = Pool_intern(name);
+  if (s->name == NULL) {
+    Kernel_freeCells(s->base, size);
+    return -1;
+  }
+  s->size = size;
+  s->refs = 1;
+  memset(&global_heap[s->base], 0, size * sizeof(int));
+
+  if (init_path != NULL && !Shm_load(s, init_path)) {
+    Shm_unref(empty);
+    return -1;
+  }
+  t->shm_mask |= (1 << empty);
+  return Shm_vbase(empty);
+}
+
+int Shm_detach(Task* t, int vaddr) {
+  for (int n = 0; n < SHM_SLOTS; n++) {
+    if ((t->shm_mask & (1 << n)) && vaddr == Shm_vbase(n)) {
+      t->shm_mask &= ~(1 << n);
+      Shm_unref(n);
+      return 0;
+    }
+  }
+  return -1;
+}
+
+void Shm_releaseTask(Task* t) {
+  for (int n = 0; n < SHM_SLOTS; n++) {
+    if (t->shm_mask & (1 << n)) Shm_unref(n);
+  }
+  t->shm_mask = 0;
+}
+
+int Shm_physAddr(Task* t, int vaddr) {
+  int n = (vaddr - SHM_VBASE) / GLOBAL_HEAP_SIZE;
+  if (n >= SHM_SLOTS || (t->shm_mask & (1 << n)) == 0) return -1;
+  int off = vaddr - Shm_vbase(n);
+  return (off < segs[n].size) ? segs[n].base + off : -1;
+}
@@ -0,0 +1,25 @@
+#ifndef SHM_H
+#define SHM_H
+
+#include "Task.h"
+
+// -----------------------------------------------------------------
+// [공유 메모리 세그먼트]
+// 이름 있는 전역 힙 영역 (SHM_SLOTS 개). 처음 만드는 태스크가 크기를 정하고
+// (원하면 SD 파일 내용으로 한 번만 채움), 같은 이름으로 다시 요청하면 그대로 붙입니다.
+// 세그먼트 n 은 모든 태스크에서 같은 가상 주소 SHM_VBASE + n * GLOBAL_HEAP_SIZE 로 보이며
+// Kernel_getPhysAddr 가 붙인 태스크에 대해서만 변환합니다.
+// 붙인 태스크 수를 세어 마지막 태스크가 떼거나 종료하면 힙 칸과 이름을 반납합니다.
+// -----------------------------------------------------------------
+
+static_assert(SHM_SLOTS <= 8, "Task::shm_mask is uint8_t");
+
+void Shm_init();
+// 만들기/붙이기: 가상 시작 주소, 실패 (자리/힙 부족, 기존 세그먼트가 더 작음, 파일 오류) 시 -1
+//   init_path: 새로 만들 때 채울 파일의 절대 경로 (NULL 이면 0 으로 채움, 한 칸에 한 바이트)
+int  Shm_attach(Task* t, const char* name, int size, const char* init_path);
+int  Shm_detach(Task* t, int vaddr);      // 0 = 성공, -1 = 붙인 세그먼트 시작 주소가 아님
+void Shm_releaseTask(Task* t);            // 태스크가 붙인 세그먼트를 모두 뗌
+int  Shm_physAddr(Task* t, int vaddr);    // 공유 창 주소 -> 물리 주소 (안 붙였거나 범위 밖이면 -1)
+
+#endif
@@ -0,0 +1,168 @@
+#include "Stats.h"
+#include "Kernel.h"
+#include "HAL.h"
+#include "Communication.h"
+#include "Trace.h"
+#include "Pool.h"
+#include "Mmap.h"
+#include "Swap.h"
+#include <FreeStack.h>
+
+extern char __data_start; // 링커 심볼: .data 시작 (FreeStack.h 의 __bss_end 와 짝)
+
+KernelStats kstats;
+
+// --- 스냅샷 직렬화 헬퍼 (LE) ---
+static uint8_t* put16(uint8_t* p, uint16_t v) {
+  p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8);
+  return p + 2;
+}
+
+static uint8_t* put32(uint8_t* p, uint32_t v) {
+  for (int i = 0; i < 4; i++) p[i] = (uint8_t)(v >> (8 * i));
+  return p + 4;
+}
+
+#define STATS_NAME_LEN 12
+
+// 스냅샷 형식 (PT_BYTES, LE)
+//   [ver u8 = 1][task_count u8][uptime_ms u32]
+//   [sd_read u32][sd_write u32][pkts_rx u32][pkts_tx u32][bytes_rx u32][bytes_tx u32]
+//   [crc_errors u16][dropped u16]
+//   task_count x [id u8][state i8][isa u8][allocs u8]
+//                [instructions u32][turns u32][sleep_ms u32][wait_ms u32][blocked_ms u32]
+//                [refills u16][seeks u16][heap_cells u16][name 12B, NULL 패딩]
+//   [mmap_hits u32][mmap_misses u32][mmap_writebacks u32]  (뒤에 붙는 값은 옛 클라이언트가 무시)
+//   [swap_outs u32][swap_ins u32][swap_out_us u32][swap_in_us u32][swap_max_us u32]
+// 스냅샷과 메모리 보고는 HAL 송신 버퍼에 바로 씀 (별도 정적 버퍼 없음)
+#define STATS_SNAPSHOT_BYTES (6 + 28 + TASK_COUNT * (4 + 20 + 6 + STATS_NAME_LEN) + 12 + 20)
+static_assert(STATS_SNAPSHOT_BYTES <= HAL_TX_PAYLOAD_MAX, "TASK_COUNT: 스냅샷이 HAL 송신 버퍼를 넘음");
+
+void Stats_sendSnapshot() {
+  uint8_t* out = HAL_txPayload();
+  uint8_t* p = out;
+
+  noInterrupts();
+  uint32_t now = system_ticks;
+  interrupts();
+
+  *p++ = 1;
+  *p++ = TASK_COUNT;
+  p = put32(p, now);
+  p = put32(p, kstats.sd_sectors_read);
+  p = put32(p, kstats.sd_sectors_written);
+  p = put32(p, kstats.pkts_rx);
+  p = put32(p, kstats.pkts_tx);
+  p = put32(p, kstats.bytes_rx);
+  p = put32(p, kstats.bytes_tx);
+  p = put16(p, kstats.crc_errors);
+  p = put16(p, kstats.dropped_pkts);
+
+  for (int i = 0; i < TASK_COUNT; i++) {
+    Task* t = tasks[i];
+    const TaskStats* st = &t->stats;
+
+    int heap_cells = t->isActive() ? t->heap_limit : 0;
+    uint8_t allocs = 0;
+    for (int k = 0; k < MAX_ALLOCATIONS; k++) {
+      if (t->alloc_table[k].ptr != -1) {
+        heap_cells += t->alloc_table[k].size;
+        allocs++;
+      }
+    }
+
+    // 진행 중인 sleep/wait/blocked 시간도 반영
+    uint32_t pending = (st->state_since != 0) ? now - st->state_since : 0;
+    uint32_t sleep_ms = st->sleep_ms + ((t->wake_up_time != 0) ? pending : 0);
+    uint32_t wait_ms = st->wait_ms + ((t->getWaitingFor() != -1) ? pending : 0);
+    uint32_t blocked_ms = st->blocked_ms;
+    if (t->wake_up_time == 0 && t->getWaitingFor() == -1) blocked_ms += pending;
+
+    *p++ = (uint8_t)i;
+    *p++ = (uint8_t)t->task_state;
+    *p++ = t->isa;
+    *p++ = allocs;
+    p = put32(p, st->instructions);
+    p = put32(p, st->turns);
+    p = put32(p, sleep_ms);
+    p = put32(p, wait_ms);
+    p = put32(p, blocked_ms);
+    p = put16(p, st->refills);
+    p = put16(p, st->seeks);
+    p = put16(p, (uint16_t)heap_cells);
+
+    const char* name = (i == 0) ? "[comm]" : ((t->isActive() && t->filename) ? t->filename : "");
+    memset(p, 0, STATS_NAME_LEN);
+    strncpy((char*)p, name, STATS_NAME_LEN);
+    p += STATS_NAME_LEN;
+  }
+
+  p = put32(p, mmap_stats.hits);
+  p = put32(p, mmap_stats.misses);
+  p = put32(p, mmap_stats.writebacks);
+  p = put32(p, swap_stats.outs);
+  p = put32(p, swap_stats.ins);
+  p = put32(p, swap_stats.out_us);
+  p = put32(p, swap_stats.in_us);
+  p = put32(p, swap_stats.max_us);
+
+  HAL_sendTxPayload(CMD_STATS, PT_BYTES, (uint32_t)(p - out));
+}
+
+// 메모리 보고 형식 (PT_BYTES, LE, 단위: bytes / heap 은 cell)
+//   [ver u8 = 3][task_count u8]
+//   [ram_size u16][static_ram u16][stack_free u16][stack_unused u16]
+//   [sizeof_task u16][task_table u16][heap_bytes u16][heap_bitmap u16]
+//   [hal_buffers u16][comm_buffers u16][prof_bytes u16][trace_bytes u16]
+//   [heap_cells u16][heap_used u16][heap_peak u16]
+//   [sizeof_task_cold u16][slots_used u16][pool_used u16][pool_peak u16]
+//   task_count x [id u8][state i8][stack_hwm u8][stack_size u8]
+//
+// static_ram   : .data + .bss 실제 크기 (링커 심볼 __bss_end - __data_start)
+//                아래 항목별 값은 큰 소비자만이므로 클라이언트가 차이를 "other" 로 보여줌
+// task_table   : 슬롯 포인터 표 + 빈 TCB (TCB 자체는 커널 풀 = 전역 힙)
+// slots_used   : TCB 를 빌려 쓰는 슬롯 수, pool_used/peak 는 커널 풀이 빌린 전역 힙 bytes
+// stack_free   : 지금 남은 C 스택 (FreeStack)
+// stack_unused : 부팅 후 한 번도 쓰이지 않은 C 스택 (FillStack 패턴, 최악 여유분)
+static_assert(2 + 19 * 2 + TASK_COUNT * 4 <= HAL_TX_PAYLOAD_MAX, "TASK_COUNT: 메모리 보고가 HAL 송신 버퍼를 넘음");
+
+void Stats_sendMemInfo() {
+  uint8_t* out = HAL_txPayload();
+  uint8_t* p = out;
+
+  uint16_t slots_used = 0;
+  for (int i = 0; i < TASK_COUNT; i++) {
+    if (tasks[i]->id == i) slots_used++; // 빈 슬롯은 빈 TCB (id -1)
+  }
+
+  *p++ = 3;
+  *p++ = TASK_COUNT;
+  p = put16(p, (uint16_t)(RAMEND - RAMSTART + 1));
+  p = put16(p, (uint16_t)(&__bss_end - &__data_start));
+  p = put16(p, (uint16_t)FreeStack());
+  p = put16(p, (uint16_t)UnusedStack());
+  p = put16(p, (uint16_t)sizeof(Task));
+  p = put16(p, (uint16_t)(sizeof(tasks) + sizeof(Task)));
+  p = put16(p, (uint16_t)sizeof(global_heap));
+  p = put16(p, (uint16_t)(GLOBAL_HEAP_SIZE / 8));
+  p = put16(p, HAL_bufferBytes());
+  p = put16(p, Comm_bufferBytes());
+  p = put16(p, (uint16_t)(PROF_SLOTS * 5));
+  p = put16(p, (uint16_t)(ENABLE_TRACE ? TRACE_BUFFER_SIZE * 8 : 0));
+  p = put16(p, GLOBAL_HEAP_SIZE);
+  p = put16(p, (uint16_t)heap_used);
+  p = put16(p, (uint16_t)heap_peak);
+  p = put16(p, (uint16_t)sizeof(TaskCold));
+  p = put16(p, slots_used);
+  p = put16(p, Pool_usedBytes());
+  p = put16(p, Pool_peakBytes());
+
+  for (int i = 0; i < TASK_COUNT; i++) {
+    *p++ = (uint8_t)i;
+    *p++ = (uint8_t)tasks[i]->task_state;
+    *p++ = tasks[i]->stack_hwm;
+    *p++ = tasks[i]->stack_size;
+  }
+
+  HAL_sendTxPayload(CMD_MEMINFO, PT_BYTES, (uint32_t)(p - out));
+}
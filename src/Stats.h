@@ -0,0 +1,41 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <stdint.h>
+
+// -----------------------------------------------------------------
+// [Kernel Statistics]
+// 전역 카운터(kstats)와 태스크별 카운터(Task::stats)를 모아
+// CMD_STATS 요청 시 바이너리 스냅샷으로 전송합니다. (클라이언트 `top`)
+// -----------------------------------------------------------------
+
+// --- 태스크별 ---
+struct TaskStats {
+  uint32_t instructions; // 실행한 VM 명령 수
+  uint32_t turns;        // 스케줄러가 CPU를 준 횟수
+  uint32_t sleep_ms;     // SLEEP 으로 잠든 시간
+  uint32_t wait_ms;      // 자식 종료를 기다린 시간
+  uint32_t blocked_ms;   // 입력(STDIN)이 없어 막혀 있던 시간
+  uint16_t refills;      // 코드 버퍼 재장전 횟수
+  uint16_t seeks;        // 점프(seek) 횟수
+  uint32_t state_since;  // 현재 sleep/wait/blocked 상태에 들어간 시각 (0: 해당 없음)
+};
+
+// --- 전역 ---
+struct KernelStats {
+  uint32_t sd_sectors_read;
+  uint32_t sd_sectors_written;
+  uint32_t pkts_rx;
+  uint32_t pkts_tx;
+  uint32_t bytes_rx;
+  uint32_t bytes_tx;
+  uint16_t crc_errors;   // CRC 불일치로 버린 패킷
+  uint16_t dropped_pkts; // 수신 버퍼 넘침/형식 오류로 버린 패킷
+};
+
+extern KernelStats kstats;
+
+void Stats_sendSnapshot(); // CMD_STATS 응답 전송
+void Stats_sendMemInfo();  // CMD_MEMINFO 응답 전송
+
+#endif
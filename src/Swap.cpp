@@ -0,0 +1,108 @@
+#include "Swap.h"
+#include "Kernel.h"
+#include "HAL.h"
+#include "KFile.h"
+
+#define SWAP_SLOT_BYTES ((uint32_t)GLOBAL_HEAP_SIZE * sizeof(int))
+#define SWAP_FILE_BYTES (SWAP_SLOT_BYTES * TASK_COUNT)
+
+static File32 swap_file;
+static bool swap_ready = false;
+
+SwapStats swap_stats;
+
+void Swap_init() {
+  memset(&swap_stats, 0, sizeof(swap_stats));
+  swap_ready = false;
+  if (swap_file.isOpen()) swap_file.close();
+  if (!Kernel_openFile(SWAP_PATH, O_RDWR | O_CREAT, &swap_file)) {
+    HAL_write(FD_STDERR, "Warn: swap disabled (cannot open " SWAP_PATH ")\n");
+    return;
+  }
+
+  // 처음 한 번: 연속 클러스터를 잡고 끝까지 채워 둠 (seekSet 이 파일 크기를 넘지 못하므로)
+  if (swap_file.fileSize() < SWAP_FILE_BYTES) {
+    swap_file.truncate(0);
+    swap_file.preAllocate(SWAP_FILE_BYTES); // 실패해도 진행 (조각난 파일이면 느릴 뿐)
+    static const uint8_t zeros[32] = {0};
+    while (swap_file.fileSize() < SWAP_FILE_BYTES) {
+      if (swap_file.write(zeros, sizeof(zeros)) != sizeof(zeros)) {
+        HAL_write(FD_STDERR, "Warn: swap disabled (SD full)\n");
+        swap_file.close();
+        return;
+      }
+    }
+    swap_file.sync();
+  }
+  swap_ready = true;
+}
+
+static void Swap_account(uint32_t* total, uint32_t t0) {
+  uint32_t dt = micros() - t0;
+  *total += dt;
+  if (dt > swap_stats.max_us) swap_stats.max_us = dt;
+}
+
+// 내보낼 수 있는 태스크: 세그먼트가 올라와 있고, 잠들었거나 자식을 기다리며, 지금 실행 중이 아님
+static bool Swap_isIdle(const Task* t) {
+  return t->id != 0 && t->id != kernel_current_task && t->isActive() &&
+         t->heap_base != -1 && t->heap_limit > 0 &&
+         (t->wake_up_time != 0 || t->getWaitingFor() != -1);
+}
+
+static bool Swap_out(Task* t) {
+  uint32_t t0 = micros();
+  uint16_t bytes = t->heap_limit * sizeof(int);
+  if (!swap_file.seekSet(SWAP_SLOT_BYTES * t->id) ||
+      swap_file.write(&global_heap[t->heap_base], bytes) != bytes) {
+    return false;
+  }
+  Kernel_freeCells(t->heap_base, t->heap_limit);
+  t->heap_base = -1;
+  swap_stats.outs++;
+  Swap_account(&swap_stats.out_us, t0);
+  return true;
+}
+
+bool Swap_outVictim() {
+  if (!swap_ready) return false;
+
+  // 자식을 기다리는 태스크를 먼저, 그다음 가장 늦게 깨어날 태스크
+  Task* victim = NULL;
+  for (int i = 1; i < TASK_COUNT; i++) {
+    Task* t = tasks[i];
+    if (!Swap_isIdle(t)) continue;
+    if (victim == NULL) { victim = t; continue; }
+    bool t_wait = t->getWaitingFor() != -1;
+    bool v_wait = victim->getWaitingFor() != -1;
+    if (t_wait != v_wait) {
+      if (t_wait) victim = t;
+    } else if (!t_wait && t->wake_up_time > victim->wake_up_time) {
+      victim = t;
+    }
+  }
+  return victim != NULL && Swap_out(victim);
+}
+
+bool Swap_in(Task* t) {
+  uint32_t t0 = micros();
+  int base = Kernel_allocCells(t->heap_limit); // 필요하면 다른 쉬는 태스크를 내보냄
+  if (base == -1) return false;
+
+  uint16_t bytes = t->heap_limit * sizeof(int);
+  if (!swap_file.seekSet(SWAP_SLOT_BYTES * t->id) ||
+      swap_file.read(&global_heap[base], bytes) != bytes) {
+    Kernel_freeCells(base, t->heap_limit);
+    Kernel_stdWrite(FD_STDERR, "Err: swap-in failed\n");
+    Kernel_terminateTask(t->id);
+    return false;
+  }
+  t->heap_base = base;
+  swap_stats.ins++;
+  Swap_account(&swap_stats.in_us, t0);
+  return true;
+}
+
+bool Swap_isFile(File32* f) {
+  return swap_ready && KFile_isSame(&swap_file, f);
+}
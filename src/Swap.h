@@ -0,0 +1,35 @@
+#ifndef SWAP_H
+#define SWAP_H
+
+#include "Task.h"
+
+// -----------------------------------------------------------------
+// [힙 스왑]
+// 전역 힙에 연속 자리가 없으면 Kernel_allocCells 가 잠들었거나 (SLEEP) 자식을 기다리는
+// 태스크의 기본 세그먼트 (heap_base/heap_limit) 를 SWAP_PATH 로 내보내 자리를 만듭니다.
+// 스왑 파일은 부팅 때 연속 클러스터로 한 번 잡아 두고, 태스크 n 은 n 번째 칸
+// (GLOBAL_HEAP_SIZE * sizeof(int) bytes, 섹터 정렬) 을 씁니다.
+//
+// 내보낸 태스크는 heap_base == -1 이고 heap_limit 은 그대로입니다 (Task::isSwapped).
+// 스케줄러가 그 태스크를 다시 실행하기 직전에 Swap_in 으로 새 자리 (heap_base 가 바뀔 수 있음)
+// 에 읽어 옵니다. 가상 주소는 세그먼트 기준이라 그대로 유효합니다.
+// MALLOC 블록은 절대 주소로 쓰이므로 옮기지 않습니다.
+// -----------------------------------------------------------------
+
+// 스왑 통계 (CMD_STATS 스냅샷 끝에 실림, 시간은 us)
+struct SwapStats {
+  uint32_t outs;
+  uint32_t ins;
+  uint32_t out_us;      // 내보내기 누적 시간
+  uint32_t in_us;       // 읽어 오기 누적 시간
+  uint32_t max_us;      // 한 번에 걸린 최대 시간 (둘 중)
+};
+
+extern SwapStats swap_stats;
+
+void Swap_init();              // 스왑 파일 열기/준비 (실패하면 스왑 끔)
+bool Swap_outVictim();         // 내보낼 태스크 하나를 골라 내보냄 (없거나 실패하면 false)
+bool Swap_in(Task* t);         // 세그먼트 읽어 오기 (자리가 없으면 false, 다음 차례에 재시도)
+bool Swap_isFile(File32* f);   // f 가 열어 둔 스왑 파일인지 (지우기 거부용)
+
+#endif
@@ -1,8 +1,16 @@
 #include "Kernel.h"
+#include "Trace.h"
 #include "syscall/SysLs.h"
 #include "syscall/SysExec.h"
 #include "syscall/SysChdir.h"
 #include "syscall/SysGetCwd.h"
+#include "syscall/SysDir.h"
+#include "syscall/SysFile.h"
+#include "syscall/SysPipe.h"
+#include "syscall/SysMbox.h"
+#include "syscall/SysShm.h"
+#include "syscall/SysMmap.h"
+#include "syscall/SysCkpt.h"
 
 // System call dispatcher
 // 1. ls
@@ -11,7 +19,15 @@
 // 4. getcwd (Get Current Working Directory)
 // 5. lcd clear
 // 6. lcd set cursor(row,col)
+// 10. opendir / 11. readdir / 12. closedir (디렉터리 커서)
+// 20. open / 21. read / 22. write / 23. seek / 24. close / 25. unlink (fd 파일 입출력, SD 또는 /tmp RAM 디스크)
+// 30. pipe
+// 40. send / 41. recv / 42. sendblk (메일박스)
+// 45. shmget / 46. shmdt (공유 세그먼트)
+// 47. mmap / 48. munmap (파일 매핑 창)
+// 50. checkpoint / 51. resume (태스크 상태 저장/재개)
 void Kernel_systemCall(Task* t, int sys_id) {
+  TRACE(TRC_SYSCALL, EV_SYSCALL_ENTER, sys_id);
   switch (sys_id) {
     case 1:
       Syscall_ls(t);
@@ -25,8 +41,66 @@ void Kernel_systemCall(Task* t, int sys_id) {
     case 4:
       Syscall_getcwd(t); // [신규]
       break;
+    case 10:
+      Syscall_opendir(t);
+      break;
+    case 11:
+      Syscall_readdir(t);
+      break;
+    case 12:
+      Syscall_closedir(t);
+      break;
+    case 20:
+      Syscall_open(t);
+      break;
+    case 21:
+      Syscall_read(t);
+      break;
+    case 22:
+      Syscall_write(t);
+      break;
+    case 23:
+      Syscall_seek(t);
+      break;
+    case 24:
+      Syscall_close(t);
+      break;
+    case 25:
+      Syscall_unlink(t);
+      break;
+    case 30:
+      Syscall_pipe(t);
+      break;
+    case 40:
+      Syscall_send(t);
+      break;
+    case 41:
+      Syscall_recv(t);
+      break;
+    case 42:
+      Syscall_sendblk(t);
+      break;
+    case 45:
+      Syscall_shmget(t);
+      break;
+    case 46:
+      Syscall_shmdt(t);
+      break;
+    case 47:
+      Syscall_mmap(t);
+      break;
+    case 48:
+      Syscall_munmap(t);
+      break;
+    case 50:
+      Syscall_checkpoint(t);
+      break;
+    case 51:
+      Syscall_resume(t);
+      break;
     default:
       // unknown syscall: ignore for now
       break;
   }
+  TRACE(TRC_SYSCALL, EV_SYSCALL_EXIT, sys_id);
 }
@@ -3,33 +3,54 @@
 
 #include "OSConfig.h"
 #include <SdFat.h>
+#include "Stats.h"
 
 #define MAX_ALLOCATIONS 4 
 
+extern volatile unsigned long system_ticks; // HAL.cpp (통계 시각 기록용)
+
 // --- 상태 상수 정의 (1바이트 최적화) ---
-// -2: FREE, -1: RUNNING, 0+: PAUSED (Waiting for Child ID)
+// -3: BLOCKED (파이프 등 대기), -2: FREE, -1: RUNNING, 0+: PAUSED (Waiting for Child ID)
+#define TASK_BLOCKED  -3
 #define TASK_FREE     -2
 #define TASK_RUNNING  -1
 
-// --- Task Control Block (TCB) ---
+// --- TCB cold 부분 ---
+// exec 시 커널 풀(Pool.cpp)에서 할당되고 종료 시 반납됩니다.
+// (통신 데몬 Task 0 은 파일이 없으므로 cold == NULL)
+// code_buffer 는 Task::code_buf_size 바이트 (헤더의 코드 크기/PRELOAD 에 맞춰 할당)
+// /rom 실행 파일은 XIP: code_buf_size == 0, 파일은 열지 않고 rom_code 부터 플래시에서 fetch
+struct TaskCold {
+  File32 file;
+  uint16_t rom_code;      // XIP 코드 시작 (rom_image 오프셋, 헤더 제외)
+  uint8_t code_buffer[];
+};
+
+// --- Task Control Block (TCB, hot 부분) ---
+// 슬롯을 쓰는 동안만 커널 풀(전역 힙)에서 빌리며 (Kernel_claimSlot), 빈 슬롯은 공용 빈 TCB 를 가리킵니다.
+// 문자열(filename/args/cwd)은 인터닝된 풀 문자열을 가리킵니다. (Kernel_setCwd 등으로만 변경)
 struct Task {
   int id;                 
   
   // [수정] bool is_active 대신 상태 변수 사용
   int8_t task_state;       
 
-  char filename[128];                              // 파일명 보관 (확장됨)
+  const char* filename;   // 실행 파일 경로 (인터닝)
   unsigned long wake_up_time;  
-  char args[32];                                  //인자값
-  char cwd[32];                                   //작업 디렉토리 기본은 루트
+  const char* args;       // 인자값 (인터닝, 없으면 "")
+  const char* cwd;        // 작업 디렉토리 (인터닝, 기본은 루트)
 
   // 실행 상태
-  int stack[VM_STACK_SIZE]; 
+  uint8_t isa;            // EXEC_VER_STACK(v1) / EXEC_VER_REG(v2)
+  int* stack;             // VM 스택 (커널 풀, stack_size 개)
+  uint8_t stack_size;
   int sp;                 
+  uint8_t stack_hwm;      // stack[] 최대 사용 깊이 (CMD_MEMINFO)
+  int regs[VM_REG_COUNT]; // v2 레지스터 파일
   // int fp; // (현재 미사용)
 
   // [가상 메모리 정보]
-  int heap_base;  // 실제 물리 메모리 시작 주소 (Global Heap Index)
+  int heap_base;  // 실제 물리 메모리 시작 주소 (Global Heap Index, 스왑되어 있으면 -1)
   int heap_limit; // 할당된 힙 크기 (Limit)
 
   struct {
@@ -38,9 +59,21 @@ struct Task {
   } alloc_table[MAX_ALLOCATIONS];
   
   // 코드 스트리밍
-  File32 file;            
-  uint8_t code_buffer[CODE_BUFFER_SIZE]; 
+  TaskCold* cold;         // 파일 핸들 + 코드 버퍼 (커널 풀)
+  uint8_t code_buf_size;  // code_buffer 크기 (<= CODE_BUFFER_SIZE, PRELOAD 시 코드 전체, XIP 면 0)
+  uint8_t code_start;     // 파일 내 코드 시작 위치 (= 헤더 크기)
+  uint16_t code_size;     // 코드 영역 크기 (rodata 제외)
+  uint16_t rodata_len;    // 코드 뒤에 붙은 읽기 전용 데이터 크기
   int buffer_index;       
+  uint16_t buffer_pos;    // code_buffer[0] 의 코드 오프셋 (헤더 제외, 프로파일러용)
+
+  // fd 표: fd -> 커널 파일 핸들 번호 (KFile, 없으면 -1 / 0~2 가 -1 이면 시리얼)
+  int8_t fds[TASK_FDS];
+  uint8_t shm_mask;       // 붙인 공유 세그먼트 (비트 = 세그먼트 번호, Shm.h)
+  int8_t parent;          // exec 한 태스크 ID (통신 데몬이 띄웠으면 0, 메일박스 MBOX_PARENT 대상)
+
+  // 통계 (CMD_STATS)
+  TaskStats stats;
 
   // --- [Helper Methods] ---
 
@@ -62,10 +95,18 @@ struct Task {
   // 4. 상태 설정 (자식 기다리기)
   void waitForChild(int child_id) {
     task_state = (int8_t)child_id; // 해당 자식 ID를 저장하며 PAUSED 상태로 전환
+    stats.state_since = system_ticks;
   }
 
   // 5. 상태 설정 (깨우기/실행)
   void setRunning() {
+    if (task_state >= 0 && stats.state_since != 0) { // 자식 대기 종료
+      stats.wait_ms += system_ticks - stats.state_since;
+      stats.state_since = 0;
+    } else if (task_state == TASK_BLOCKED && stats.state_since != 0) { // 커널 객체 대기 종료
+      stats.blocked_ms += system_ticks - stats.state_since;
+      stats.state_since = 0;
+    }
     task_state = TASK_RUNNING;
   }
 
@@ -73,6 +114,26 @@ struct Task {
   void setFree() {
     task_state = TASK_FREE;
   }
+
+  // 7. 상태 설정 (커널 객체 대기, 깨어나면 막혔던 명령을 다시 실행)
+  void block() {
+    task_state = TASK_BLOCKED;
+    stats.state_since = system_ticks;
+  }
+
+  // 8. 다음에 실행할 코드 오프셋 (헤더 제외)
+  // 창을 다 썼거나 Kernel_jump 가 seek 한 직후 (재장전 대기) 에는 buffer_pos 가 옛 창이므로 파일 위치가 곧 PC
+  uint16_t codePc() const {
+    if (code_buf_size > 0 && buffer_index >= code_buf_size && cold != NULL) {
+      return (uint16_t)(cold->file.curPosition() - code_start);
+    }
+    return buffer_pos + buffer_index;
+  }
+
+  // 9. 기본 세그먼트가 스왑 파일에 있는지 (Swap.h, 실행 전에 Swap_in)
+  bool isSwapped() const {
+    return heap_base == -1 && heap_limit > 0;
+  }
 };
 
 #endif
\ No newline at end of file
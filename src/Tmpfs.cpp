@@ -0,0 +1,267 @@
+#include "Tmpfs.h"
+#include "Kernel.h"
+
+#define TMPFS_BLOCKS ((TMPFS_CELLS * 2) / TMPFS_BLOCK)
+#define BLK_FREE 0xFF  // next[]: 빈 블록
+#define BLK_END  0xFE  // next[]: 체인 끝 / 빈 파일의 first
+
+#define H_READ  0x01
+#define H_WRITE 0x02
+#define H_APPEND 0x04
+#define H_DIR   0x08
+
+static_assert(TMPFS_BLOCKS <= 250, "block numbers are uint8_t");
+static_assert(TMPFS_FD_BASE + TMPFS_HANDLES <= 32, "handles must stay below PIPE_FD_BASE");
+
+struct TmpNode {
+  char name[TMPFS_NAME_MAX]; // name[0] == 0 이면 빈 칸
+  uint8_t first;             // 첫 블록 (BLK_END = 비어 있음)
+  uint16_t size;
+};
+
+struct TmpHandle {
+  int8_t owner;  // -1 = 빈 칸
+  int8_t node;   // 파일 번호 (디렉터리 커서는 -1)
+  uint8_t flags; // H_*
+  uint16_t pos;  // 파일 위치 / 디렉터리 커서 (다음 이름 표 번호)
+};
+
+static uint8_t*  data = NULL;   // 전역 힙 칸을 바이트 배열로 사용 (NULL = tmpfs 꺼짐)
+static uint8_t   next_blk[TMPFS_BLOCKS > 0 ? TMPFS_BLOCKS : 1];
+static TmpNode   nodes[TMPFS_FILES];
+static TmpHandle handles[TMPFS_HANDLES];
+
+void Tmpfs_init() {
+  memset(nodes, 0, sizeof(nodes));
+  memset(next_blk, BLK_FREE, sizeof(next_blk));
+  for (int i = 0; i < TMPFS_HANDLES; i++) handles[i].owner = -1;
+
+  data = NULL;
+  if (TMPFS_BLOCKS == 0) return;
+  int base = Kernel_allocCells(TMPFS_CELLS);
+  if (base != -1) data = (uint8_t*)&global_heap[base];
+}
+
+// "/tmp" -> "", "/tmp/a" -> "a", 그 외 NULL
+static const char* Tmpfs_leaf(const char* abs_path) {
+  if (data == NULL) return NULL;
+  size_t n = strlen(TMPFS_MOUNT);
+  if (strncmp(abs_path, TMPFS_MOUNT, n) != 0) return NULL;
+  if (abs_path[n] == '\0') return abs_path + n;
+  if (abs_path[n] != '/') return NULL;
+  return abs_path + n + 1;
+}
+
+bool Tmpfs_isPath(const char* abs_path) {
+  return Tmpfs_leaf(abs_path) != NULL;
+}
+
+static int Tmpfs_find(const char* leaf) {
+  for (int i = 0; i < TMPFS_FILES; i++) {
+    if (nodes[i].name[0] != '\0' && strcmp(nodes[i].name, leaf) == 0) return i;
+  }
+  return -1;
+}
+
+static TmpHandle* Tmpfs_handle(int8_t v) {
+  if (!Tmpfs_isEnd(v)) return NULL;
+  TmpHandle* h = &handles[v - TMPFS_FD_BASE];
+  return (h->owner == -1) ? NULL : h;
+}
+
+static void Tmpfs_freeChain(uint8_t b) {
+  while (b != BLK_END) {
+    uint8_t n = next_blk[b];
+    next_blk[b] = BLK_FREE;
+    b = n;
+  }
+}
+
+static uint8_t Tmpfs_allocBlock() {
+  for (uint8_t b = 0; b < TMPFS_BLOCKS; b++) {
+    if (next_blk[b] == BLK_FREE) {
+      next_blk[b] = BLK_END;
+      return b;
+    }
+  }
+  return BLK_END;
+}
+
+bool Tmpfs_stat(const char* abs_path, bool* is_dir, uint16_t* size) {
+  const char* leaf = Tmpfs_leaf(abs_path);
+  if (leaf == NULL) return false;
+  if (leaf[0] == '\0' || strcmp(leaf, "/") == 0) {
+    *is_dir = true;
+    *size = 0;
+    return true;
+  }
+  int i = Tmpfs_find(leaf);
+  if (i == -1) return false;
+  *is_dir = false;
+  *size = nodes[i].size;
+  return true;
+}
+
+bool Tmpfs_unlink(const char* abs_path) {
+  const char* leaf = Tmpfs_leaf(abs_path);
+  int i = (leaf != NULL) ? Tmpfs_find(leaf) : -1;
+  if (i == -1) return false;
+  for (int k = 0; k < TMPFS_HANDLES; k++) {
+    if (handles[k].owner != -1 && handles[k].node == i) return false;
+  }
+  Tmpfs_freeChain(nodes[i].first);
+  nodes[i].name[0] = '\0';
+  return true;
+}
+
+static int8_t Tmpfs_newHandle(uint8_t owner, int8_t node, uint8_t flags) {
+  for (int k = 0; k < TMPFS_HANDLES; k++) {
+    TmpHandle* h = &handles[k];
+    if (h->owner != -1) continue;
+    h->owner = owner;
+    h->node = node;
+    h->flags = flags;
+    h->pos = 0;
+    return TMPFS_FD_BASE + k;
+  }
+  return -1;
+}
+
+int8_t Tmpfs_open(uint8_t owner, const char* abs_path, oflag_t oflag) {
+  const char* leaf = Tmpfs_leaf(abs_path);
+  if (leaf == NULL || leaf[0] == '\0' || strchr(leaf, '/') != NULL) return -1;
+
+  int i = Tmpfs_find(leaf);
+  if (i == -1) {
+    if (!(oflag & O_CREAT) || strlen(leaf) >= TMPFS_NAME_MAX) return -1;
+    for (int k = 0; k < TMPFS_FILES && i == -1; k++) {
+      if (nodes[k].name[0] == '\0') i = k;
+    }
+    if (i == -1) return -1;
+    strcpy(nodes[i].name, leaf);
+    nodes[i].first = BLK_END;
+    nodes[i].size = 0;
+  }
+
+  uint8_t flags = 0;
+  if ((oflag & O_WRONLY) == 0) flags |= H_READ;
+  if (oflag & (O_WRONLY | O_RDWR)) flags |= H_WRITE;
+  if (oflag & O_APPEND) flags |= H_APPEND;
+  int8_t v = Tmpfs_newHandle(owner, i, flags);
+  if (v != -1 && (oflag & O_TRUNC)) {
+    Tmpfs_freeChain(nodes[i].first);
+    nodes[i].first = BLK_END;
+    nodes[i].size = 0;
+  }
+  return v;
+}
+
+int8_t Tmpfs_opendir(uint8_t owner, const char* abs_path) {
+  const char* leaf = Tmpfs_leaf(abs_path);
+  if (leaf == NULL || (leaf[0] != '\0' && strcmp(leaf, "/") != 0)) return -1;
+  return Tmpfs_newHandle(owner, -1, H_DIR);
+}
+
+bool Tmpfs_valid(int8_t v, uint8_t owner) {
+  TmpHandle* h = Tmpfs_handle(v);
+  return h != NULL && h->owner == owner;
+}
+
+void Tmpfs_close(int8_t v) {
+  TmpHandle* h = Tmpfs_handle(v);
+  if (h != NULL) h->owner = -1;
+}
+
+void Tmpfs_releaseOwner(uint8_t owner) {
+  for (int k = 0; k < TMPFS_HANDLES; k++) {
+    if (handles[k].owner == owner) handles[k].owner = -1;
+  }
+}
+
+// pos 가 들어 있는 블록 (체인이 짧으면 grow 일 때만 늘림, 실패 시 BLK_END)
+static uint8_t Tmpfs_blockAt(TmpNode* n, uint16_t pos, bool grow) {
+  uint8_t* link = &n->first;
+  for (uint16_t i = 0; ; i++) {
+    if (*link == BLK_END) {
+      if (!grow) return BLK_END;
+      uint8_t b = Tmpfs_allocBlock();
+      if (b == BLK_END) return BLK_END;
+      *link = b;
+    }
+    if (i == pos / TMPFS_BLOCK) return *link;
+    link = &next_blk[*link];
+  }
+}
+
+int Tmpfs_read(int8_t v, uint8_t* dst, int len) {
+  TmpHandle* h = Tmpfs_handle(v);
+  if (h == NULL || !(h->flags & H_READ) || h->node < 0) return -1;
+  TmpNode* n = &nodes[h->node];
+
+  int total = 0;
+  while (total < len && h->pos < n->size) {
+    uint8_t b = Tmpfs_blockAt(n, h->pos, false);
+    uint16_t off = h->pos % TMPFS_BLOCK;
+    int k = TMPFS_BLOCK - off;
+    if (k > n->size - h->pos) k = n->size - h->pos;
+    if (k > len - total) k = len - total;
+    memcpy(dst + total, data + b * TMPFS_BLOCK + off, k);
+    total += k;
+    h->pos += k;
+  }
+  return total;
+}
+
+int Tmpfs_write(int8_t v, const uint8_t* src, int len) {
+  TmpHandle* h = Tmpfs_handle(v);
+  if (h == NULL || !(h->flags & H_WRITE) || h->node < 0) return -1;
+  TmpNode* n = &nodes[h->node];
+  if (h->flags & H_APPEND) h->pos = n->size;
+
+  int total = 0;
+  while (total < len) {
+    uint8_t b = Tmpfs_blockAt(n, h->pos, true);
+    if (b == BLK_END) break; // 공간 없음
+    uint16_t off = h->pos % TMPFS_BLOCK;
+    int k = TMPFS_BLOCK - off;
+    if (k > len - total) k = len - total;
+    memcpy(data + b * TMPFS_BLOCK + off, src + total, k);
+    total += k;
+    h->pos += k;
+    if (h->pos > n->size) n->size = h->pos;
+  }
+  return total;
+}
+
+int Tmpfs_readdir(int8_t v, char* name, int cap, uint16_t* size) {
+  TmpHandle* h = Tmpfs_handle(v);
+  if (h == NULL || !(h->flags & H_DIR)) return -1;
+  while (h->pos < TMPFS_FILES) {
+    TmpNode* n = &nodes[h->pos++];
+    if (n->name[0] == '\0') continue;
+    strncpy(name, n->name, cap - 1);
+    name[cap - 1] = '\0';
+    *size = n->size;
+    return 1;
+  }
+  return 0;
+}
+
+uint16_t Tmpfs_tell(int8_t v) {
+  TmpHandle* h = Tmpfs_handle(v);
+  return (h != NULL) ? h->pos : 0;
+}
+
+bool Tmpfs_seek(int8_t v, uint16_t pos) {
+  TmpHandle* h = Tmpfs_handle(v);
+  if (h == NULL) return false;
+  uint16_t limit = (h->flags & H_DIR) ? TMPFS_FILES : nodes[h->node].size;
+  if (pos > limit) return false;
+  h->pos = pos;
+  return true;
+}
+
+uint16_t Tmpfs_size(int8_t v) {
+  TmpHandle* h = Tmpfs_handle(v);
+  return (h != NULL && h->node >= 0) ? nodes[h->node].size : 0;
+}
@@ -0,0 +1,43 @@
+#ifndef TMPFS_H
+#define TMPFS_H
+
+#include "OSConfig.h"
+#include <SdFat.h> // oflag_t (O_*)
+
+// -----------------------------------------------------------------
+// [tmpfs - RAM 디스크]
+// TMPFS_MOUNT 아래 경로는 SD 대신 전역 힙의 TMPFS_CELLS 칸 (칸당 2바이트)에 저장합니다.
+// 디렉터리 없이 평평한 이름 표 (TMPFS_FILES 개) 와 TMPFS_BLOCK 바이트 블록 체인으로 구성되며
+// 전원이 꺼지면 내용은 사라집니다.
+//
+// 열린 파일/디렉터리 커서는 핸들 표 (TMPFS_HANDLES 개) 에 있고, 값은 TMPFS_FD_BASE 부터라
+// 태스크 fd 표 (Task::fds) 에 KFile 번호/파이프 끝과 섞여 들어갈 수 있습니다.
+// 핸들은 소유 태스크가 종료되면 Kernel_terminateTask 에서 함께 닫힙니다.
+// -----------------------------------------------------------------
+
+#define TMPFS_MOUNT    "/tmp"
+#define TMPFS_FD_BASE  16    // 핸들 값 = TMPFS_FD_BASE + 번호 (KFile 번호 < 16, 파이프 끝 >= PIPE_FD_BASE)
+#define TMPFS_NAME_MAX 12    // 파일 이름 (NULL 포함)
+
+inline bool Tmpfs_isEnd(int8_t v) { return v >= TMPFS_FD_BASE && v < TMPFS_FD_BASE + TMPFS_HANDLES; }
+
+void   Tmpfs_init();
+bool   Tmpfs_isPath(const char* abs_path);   // TMPFS_MOUNT 자체 또는 그 아래 (tmpfs 가 꺼져 있으면 false)
+bool   Tmpfs_stat(const char* abs_path, bool* is_dir, uint16_t* size);
+bool   Tmpfs_unlink(const char* abs_path);   // 열려 있는 파일은 지울 수 없음
+
+int8_t Tmpfs_open(uint8_t owner, const char* abs_path, oflag_t oflag); // 핸들 값, 실패 시 -1
+int8_t Tmpfs_opendir(uint8_t owner, const char* abs_path);             // TMPFS_MOUNT 만 가능
+bool   Tmpfs_valid(int8_t v, uint8_t owner);                            // owner 의 열린 핸들인지
+void   Tmpfs_close(int8_t v);
+void   Tmpfs_releaseOwner(uint8_t owner);
+
+int    Tmpfs_read(int8_t v, uint8_t* dst, int len);        // 읽은 수 (0 = 끝), 쓰기 전용이면 -1
+int    Tmpfs_write(int8_t v, const uint8_t* src, int len); // 쓴 수 (공간이 모자라면 짧음), 읽기 전용이면 -1
+// 디렉터리 커서: 1 = 항목 기록, 0 = 끝, -1 = 디렉터리 핸들 아님
+int    Tmpfs_readdir(int8_t v, char* name, int cap, uint16_t* size);
+uint16_t Tmpfs_tell(int8_t v);                       // 파일 위치 / 디렉터리 커서 위치
+bool   Tmpfs_seek(int8_t v, uint16_t pos);           // 파일 끝까지만 (디렉터리는 커서 되감기)
+uint16_t Tmpfs_size(int8_t v);                       // 파일 크기 (디렉터리는 0)
+
+#endif
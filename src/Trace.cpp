@@ -0,0 +1,95 @@
+#include "Trace.h"
+#include "Kernel.h"
+#include "HAL.h"
+
+#if ENABLE_TRACE
+
+// 이벤트 1개 = 8바이트
+//   time: 상위 24비트 = system_ticks(ms), 하위 8비트 = TCNT1 (4us 단위, 0~249)
+struct TraceEntry {
+  uint32_t time;
+  uint8_t  event;
+  uint8_t  task;  // 기록 시점의 kernel_current_task (0xFF: 없음)
+  uint16_t arg;
+};
+
+uint8_t trace_mask = 0; // 기본값: 모두 꺼짐 ("trace mask" 명령으로 켬)
+
+static TraceEntry trace_buf[TRACE_BUFFER_SIZE];
+static uint8_t trace_head = 0;  // 다음에 쓸 위치
+static uint8_t trace_count = 0; // 쌓인 이벤트 수
+static uint16_t trace_lost = 0; // 덮어써진 이벤트 수
+
+void Trace_record(uint8_t event, uint16_t arg) {
+  uint8_t sreg = SREG;
+  cli();
+  TraceEntry* e = &trace_buf[trace_head];
+  e->time = ((uint32_t)system_ticks << 8) | (uint8_t)TCNT1;
+  e->event = event;
+  e->task = (uint8_t)kernel_current_task;
+  e->arg = arg;
+  trace_head = (trace_head + 1) & (TRACE_BUFFER_SIZE - 1);
+  if (trace_count < TRACE_BUFFER_SIZE) trace_count++;
+  else trace_lost++;
+  SREG = sreg;
+}
+
+// 드레인 형식 (PT_BYTES, LE)
+//   [mask u8][lost u16][n u16] + n x [time u32][event u8][task u8][arg u16]
+// 보낸 이벤트는 버퍼에서 제거됩니다. HAL 송신 버퍼에 바로 씀 (별도 정적 버퍼 없음)
+static_assert(5 + TRACE_BUFFER_SIZE * 8 <= HAL_TX_PAYLOAD_MAX, "TRACE_BUFFER_SIZE: 드레인이 HAL 송신 버퍼를 넘음");
+
+static void Trace_drain() {
+  uint8_t* out = HAL_txPayload();
+  uint8_t* p = out + 5;
+
+  uint8_t sreg = SREG;
+  cli();
+  uint8_t n = trace_count;
+  uint8_t idx = (trace_head - n) & (TRACE_BUFFER_SIZE - 1);
+  for (uint8_t i = 0; i < n; i++) {
+    const TraceEntry* e = &trace_buf[idx];
+    for (int b = 0; b < 4; b++) p[b] = (uint8_t)(e->time >> (8 * b));
+    p[4] = e->event;
+    p[5] = e->task;
+    p[6] = (uint8_t)(e->arg & 0xFF);
+    p[7] = (uint8_t)(e->arg >> 8);
+    p += 8;
+    idx = (idx + 1) & (TRACE_BUFFER_SIZE - 1);
+  }
+  uint16_t lost = trace_lost;
+  trace_count = 0;
+  trace_lost = 0;
+  SREG = sreg;
+
+  out[0] = trace_mask;
+  out[1] = (uint8_t)(lost & 0xFF);
+  out[2] = (uint8_t)(lost >> 8);
+  out[3] = n;
+  out[4] = 0;
+
+  HAL_sendTxPayload(CMD_TRACE, PT_BYTES, (uint32_t)(p - out));
+}
+
+#endif
+
+// 요청 (PT_STRING): "mask <hex>" | "drain"
+void Trace_command(const uint8_t* payload, int len) {
+  char cmd[16];
+  if (len > 15) len = 15;
+  memcpy(cmd, payload, len);
+  cmd[len] = 0;
+
+#if ENABLE_TRACE
+  if (strncmp(cmd, "mask", 4) == 0) {
+    trace_mask = (uint8_t)strtol(cmd + 4, NULL, 16);
+    HAL_write(FD_STDOUT, "Trace mask set.\n");
+  } else if (strcmp(cmd, "drain") == 0) {
+    Trace_drain();
+  } else {
+    HAL_write(FD_STDERR, "Usage: trace mask <hex> | drain\n");
+  }
+#else
+  HAL_write(FD_STDERR, "Trace disabled (ENABLE_TRACE 0)\n");
+#endif
+}
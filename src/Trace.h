@@ -0,0 +1,54 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include "OSConfig.h"
+
+// -----------------------------------------------------------------
+// [Kernel Event Trace]
+// 타임스탬프가 붙은 커널 이벤트를 고정 크기 링 버퍼에 기록합니다.
+// 버퍼가 차면 가장 오래된 이벤트를 덮어씁니다. (lost 카운트 증가)
+//
+// - 컴파일 타임: ENABLE_TRACE 0 이면 TRACE() 는 아무 코드도 생성하지 않음
+// - 런타임: trace_mask 의 카테고리 비트가 꺼져 있으면 비교 1회로 끝남
+// -----------------------------------------------------------------
+
+// --- 카테고리 (trace_mask 비트) ---
+#define TRC_SCHED   0x01 // 태스크 전환
+#define TRC_SYSCALL 0x02 // 시스템 콜 진입/종료
+#define TRC_CODE    0x04 // 코드 버퍼 재장전 / 점프(seek)
+#define TRC_SD      0x08 // SD 섹터 읽기/쓰기
+#define TRC_COMM    0x10 // 패킷 수신 / 송신
+#define TRC_MEM     0x20 // malloc / free
+#define TRC_TASK    0x40 // 태스크 로드 / 종료
+
+// --- 이벤트 ID (arg 의미) ---
+enum TraceEvent : uint8_t {
+  EV_TASK_SWITCH   = 1,  // 새로 실행되는 태스크 ID
+  EV_SYSCALL_ENTER = 2,  // 시스템 콜 ID
+  EV_SYSCALL_EXIT  = 3,  // 시스템 콜 ID
+  EV_REFILL        = 4,  // 재장전한 코드 오프셋
+  EV_SEEK          = 5,  // 점프 대상 코드 오프셋
+  EV_SD_READ       = 6,  // 섹터 번호 (하위 16비트)
+  EV_SD_WRITE      = 7,  // 섹터 번호 (하위 16비트)
+  EV_PKT_RX        = 8,  // 명령 ID
+  EV_PKT_TX_BEGIN  = 9,  // 명령 ID
+  EV_PKT_TX_END    = 10, // 명령 ID
+  EV_MALLOC        = 11, // 할당된 주소 (-1 실패)
+  EV_FREE          = 12, // 해제한 주소
+  EV_TASK_LOAD     = 13, // 로드된 태스크 ID
+  EV_TASK_EXIT     = 14, // 종료된 태스크 ID
+  EV_EXEC_CACHE    = 15  // exec 캐시 적중 1 / 파일 변경으로 폐기 0
+};
+
+void Trace_command(const uint8_t* payload, int len); // CMD_TRACE 요청 처리
+
+#if ENABLE_TRACE
+extern uint8_t trace_mask;
+void Trace_record(uint8_t event, uint16_t arg);
+#define TRACE(cat, ev, arg) \
+  do { if (trace_mask & (cat)) Trace_record((ev), (uint16_t)(arg)); } while (0)
+#else
+#define TRACE(cat, ev, arg) do {} while (0)
+#endif
+
+#endif
@@ -1,5 +1,9 @@
 #include "VirtualMachine.h"
 #include "OSConfig.h"
+#include "Native.h"
+#include "Rom.h"
+#include "Mmap.h"
+#include <StreamProtocol.h> // OP_ACRC (sp_crc32_update)
 
 // 외부 함수
 extern void Kernel_refillBuffer(Task* t);
@@ -14,11 +18,12 @@ extern void Kernel_terminateTask(int id);
 extern void Kernel_raiseException(Task* t, int error_code);
 extern int Kernel_malloc(Task* t, int size);
 extern int Kernel_getPhysAddr(Task* t, int virt_addr);
+extern int Kernel_readRodata(Task* t, uint16_t off, uint8_t* dst, int len);
 extern int global_heap[];
 
 // --- [안전장치] 매크로 ---
 #define CHECK_STACK_OVERFLOW(t) \
-  if (t->sp >= VM_STACK_SIZE - 1) { \
+  if (t->sp >= t->stack_size - 1) { \
     Kernel_stdWrite(FD_STDERR, "Err: Stack Overflow\n"); \
     Kernel_terminateTask(t->id); \
     return; \
@@ -31,16 +36,29 @@ extern int global_heap[];
     return; \
   }
 
+#define CHECK_HEAP_RANGE(t, ptr) \
+  if (ptr == NULL) { \
+    Kernel_stdWrite(FD_STDERR, "SegFault: Range\n"); \
+    Kernel_terminateTask(t->id); \
+    return; \
+  }
+
 // ============================================================
 // [핵심 해결책] 안전하게 1바이트 읽어오는 함수
 // 경계선(32byte)을 넘어가면 알아서 재장전합니다.
 // ============================================================
 uint8_t VM_fetchByte(Task* t) {
-  if (t->buffer_index >= CODE_BUFFER_SIZE) {
+  if (t->buffer_index >= t->code_buf_size) {
+    if (!t->isActive()) return 0; // 이미 종료됨
+    if (t->code_buf_size == 0) { // XIP (/rom): 플래시에서 바로 읽음, 코드 끝을 넘으면 종료
+      if ((uint16_t)t->buffer_index < t->code_size) return Rom_byte(t->cold->rom_code + t->buffer_index++);
+      Kernel_terminateTask(t->id);
+      return 0;
+    }
     Kernel_refillBuffer(t);
     if (!t->isActive()) return 0; // 파일 끝
   }
-  return t->code_buffer[t->buffer_index++];
+  return t->cold->code_buffer[t->buffer_index++];
 }
 
 // [신규] 2바이트 정수 읽기 (Little Endian)
@@ -50,6 +68,96 @@ int VM_fetchInt(Task* t) {
   return (int)(low | (high << 8));
 }
 
+// [배열 연산용] 가상 주소 범위 [addr, addr+len) 를 물리 포인터로 변환
+// 범위 검사와 주소 변환은 호출당 한 번만 수행합니다. (실패 시 NULL)
+int* VM_heapRange(Task* t, int addr, int len) {
+  if (len < 0) return NULL;
+  // 태스크 세그먼트 안에서 시작했다면 세그먼트 밖으로 넘어가면 안 됨
+  if (addr >= 0 && addr < t->heap_limit && (long)addr + len > t->heap_limit) return NULL;
+  // 공유 세그먼트도 마찬가지 (끝 주소가 같은 세그먼트 안이어야 함)
+  if (addr >= SHM_VBASE && len > 0 && Kernel_getPhysAddr(t, addr + len - 1) != Kernel_getPhysAddr(t, addr) + len - 1) return NULL;
+
+  int phys_addr = Kernel_getPhysAddr(t, addr);
+  if (phys_addr < 0 || (long)phys_addr + len > GLOBAL_HEAP_SIZE) return NULL;
+  return &global_heap[phys_addr];
+}
+
+// [셀 읽기/쓰기] LOAD/STORE 공용: 힙/공유 세그먼트는 물리 주소로, 파일 매핑 창은 페이지 캐시로
+static inline bool VM_loadCell(Task* t, int addr, int* out) {
+  int phys_addr = Kernel_getPhysAddr(t, addr);
+  if (phys_addr >= 0 && phys_addr < GLOBAL_HEAP_SIZE) {
+    *out = global_heap[phys_addr];
+    return true;
+  }
+  return addr >= MMAP_VBASE && Mmap_load(t, addr, out);
+}
+
+static inline bool VM_storeCell(Task* t, int addr, int val) {
+  int phys_addr = Kernel_getPhysAddr(t, addr);
+  if (phys_addr >= 0 && phys_addr < GLOBAL_HEAP_SIZE) {
+    global_heap[phys_addr] = val;
+    return true;
+  }
+  return addr >= MMAP_VBASE && Mmap_store(t, addr, val);
+}
+
+// [rodata 출력] NULL(또는 rodata 끝)까지 청크 단위로 읽어 출력
+// 64자 이하 문자열은 출력 한 번(패킷 하나)으로 나갑니다. 오프셋이 범위 밖이면 false
+bool VM_printRodata(Task* t, int fd, int off) {
+  char buf[65];
+  int n = Kernel_readRodata(t, (uint16_t)off, (uint8_t*)buf, sizeof(buf) - 1);
+  if (off < 0 || n < 0) return false;
+
+  while (n > 0) {
+    buf[n] = 0;
+    int len = strlen(buf);
+    if (len > 0) Kernel_stdWrite(fd, buf);
+    if (len < n) break; // NULL 발견
+    off += n;
+    n = Kernel_readRodata(t, (uint16_t)off, (uint8_t*)buf, sizeof(buf) - 1);
+  }
+  return true;
+}
+
+// [rodata 복사] rodata[off, off+len) 바이트를 힙 [dst, dst+len) 셀로
+bool VM_copyRodata(Task* t, int dst, int off, int len) {
+  int* p = VM_heapRange(t, dst, len);
+  if (p == NULL || off < 0) return false;
+
+  uint8_t buf[32];
+  while (len > 0) {
+    int chunk = (len < (int)sizeof(buf)) ? len : (int)sizeof(buf);
+    if (Kernel_readRodata(t, (uint16_t)off, buf, chunk) != chunk) return false;
+    for (int i = 0; i < chunk; i++) *p++ = buf[i];
+    off += chunk;
+    len -= chunk;
+  }
+  return true;
+}
+
+#define CHECK_RODATA(t, ok) \
+  if (!(ok)) { \
+    Kernel_stdWrite(FD_STDERR, "SegFault: Rodata\n"); \
+    Kernel_terminateTask(t->id); \
+    return; \
+  }
+
+// [막힘 재시도] 파이프 등에서 막힌 명령은 스택과 PC 를 명령 시작 상태로 되돌려
+// 깨어난 뒤 처음부터 다시 실행합니다. (막히는 명령은 팝/레지스터 읽기 뒤 실패하므로 sp 복원으로 충분)
+static uint16_t vm_op_pc;
+static int vm_op_sp;
+
+static inline void VM_markRetry(Task* t) {
+  vm_op_pc = t->buffer_pos + t->buffer_index - 1; // 방금 읽은 opcode 위치
+  vm_op_sp = t->sp;
+}
+
+static inline void VM_retryIfBlocked(Task* t) {
+  if (t->task_state != TASK_BLOCKED) return;
+  t->sp = vm_op_sp;
+  Kernel_jump(t, vm_op_pc);
+}
+
 // ------------------------------------------------
 // VM 메인 루프
 // ------------------------------------------------
@@ -58,6 +166,9 @@ void VM_runStep(Task* t) {
   uint8_t opcode = VM_fetchByte(t);
   
   if (!t->isActive()) return;
+  t->stats.instructions++;
+  if (t->sp >= t->stack_hwm) t->stack_hwm = t->sp + 1; // 직전 명령 종료 시점 깊이
+  VM_markRetry(t);
 
   // 2. [Execute]
   switch (opcode) {
@@ -158,6 +269,11 @@ void VM_runStep(Task* t) {
       Kernel_stdWrite(FD_STDOUT, temp_string_buffer);
       break;
     }
+    case OP_PRTR: {
+      int off = VM_fetchInt(t);
+      CHECK_RODATA(t, VM_printRodata(t, FD_STDOUT, off));
+      break;
+    }
     case OP_READ: { 
       CHECK_STACK_OVERFLOW(t);
       int val = Kernel_stdRead(FD_STDIN);
@@ -170,6 +286,11 @@ void VM_runStep(Task* t) {
       Kernel_systemCall(t, sys_id);
       break;
     }
+    case OP_NATIVE: {
+      int native_id = VM_fetchInt(t);
+      Native_call(t, native_id);
+      break;
+    }
     case OP_SLEEP: {
       CHECK_STACK_UNDERFLOW(t, 1);
       int ms = t->stack[t->sp--];
@@ -195,15 +316,14 @@ void VM_runStep(Task* t) {
       CHECK_STACK_UNDERFLOW(t, 1);
       int addr = t->stack[t->sp--];
       
-      // [주소 변환] 공통 함수 사용
-      int phys_addr = Kernel_getPhysAddr(t, addr);
-      
-      if (phys_addr >= 0 && phys_addr < GLOBAL_HEAP_SIZE) {
+      // [주소 변환] 힙은 Kernel_getPhysAddr, 파일 매핑 창은 페이지 캐시
+      int val;
+      if (VM_loadCell(t, addr, &val)) {
         CHECK_STACK_OVERFLOW(t);
-        t->stack[++t->sp] = global_heap[phys_addr];
+        t->stack[++t->sp] = val;
       } else {
         Kernel_stdWrite(FD_STDERR, "SegFault: Read ");
-        Kernel_stdWrite(FD_STDERR, phys_addr);
+        Kernel_stdWrite(FD_STDERR, addr);
         Kernel_stdWrite(FD_STDERR, "\n");
         Kernel_terminateTask(t->id);
       }
@@ -214,18 +334,363 @@ void VM_runStep(Task* t) {
       int addr = t->stack[t->sp--];
       int val  = t->stack[t->sp--];
       
-      // [주소 변환] 공통 함수 사용
-      int phys_addr = Kernel_getPhysAddr(t, addr);
+      // [주소 변환] 힙은 Kernel_getPhysAddr, 파일 매핑 창은 페이지 캐시
+      if (!VM_storeCell(t, addr, val)) {
+        Kernel_stdWrite(FD_STDERR, "SegFault: Write Addr ");
+        Kernel_stdWrite(FD_STDERR, addr);
+        Kernel_stdWriteChar(FD_STDERR, '\n');
+        Kernel_terminateTask(t->id);
+      }
+      break;
+    }
 
-      if (phys_addr >= 0 && phys_addr < GLOBAL_HEAP_SIZE) {
-        global_heap[phys_addr] = val;
-      } else {
+    case OP_RCOPY: {
+      CHECK_STACK_UNDERFLOW(t, 2);
+      int off = VM_fetchInt(t);
+      int len = t->stack[t->sp--];
+      int dst = t->stack[t->sp--];
+      CHECK_RODATA(t, VM_copyRodata(t, dst, off, len));
+      break;
+    }
+
+    // --- 배열 연산 ---
+    case OP_ASUM: {
+      CHECK_STACK_UNDERFLOW(t, 2);
+      int len  = t->stack[t->sp--];
+      int addr = t->stack[t->sp--];
+      int* a = VM_heapRange(t, addr, len);
+      CHECK_HEAP_RANGE(t, a);
+
+      int sum = 0;
+      for (int i = 0; i < len; i++) sum += a[i];
+      t->stack[++t->sp] = sum;
+      break;
+    }
+    case OP_AMIN:
+    case OP_AMAX: {
+      CHECK_STACK_UNDERFLOW(t, 2);
+      int len  = t->stack[t->sp--];
+      int addr = t->stack[t->sp--];
+      int* a = VM_heapRange(t, addr, len);
+      CHECK_HEAP_RANGE(t, a);
+      CHECK_STACK_OVERFLOW(t);
+
+      // 빈 범위면 [0, -1]
+      int best = 0;
+      int best_index = -1;
+      if (len > 0) {
+        best = a[0];
+        best_index = 0;
+        if (opcode == OP_AMIN) {
+          for (int i = 1; i < len; i++) if (a[i] < best) { best = a[i]; best_index = i; }
+        } else {
+          for (int i = 1; i < len; i++) if (a[i] > best) { best = a[i]; best_index = i; }
+        }
+      }
+      t->stack[++t->sp] = best;
+      t->stack[++t->sp] = best_index;
+      break;
+    }
+    case OP_AADDS: {
+      CHECK_STACK_UNDERFLOW(t, 3);
+      int k    = t->stack[t->sp--];
+      int len  = t->stack[t->sp--];
+      int addr = t->stack[t->sp--];
+      int* a = VM_heapRange(t, addr, len);
+      CHECK_HEAP_RANGE(t, a);
+
+      for (int i = 0; i < len; i++) a[i] += k;
+      break;
+    }
+    case OP_AMULS: {
+      CHECK_STACK_UNDERFLOW(t, 3);
+      int k    = t->stack[t->sp--];
+      int len  = t->stack[t->sp--];
+      int addr = t->stack[t->sp--];
+      int* a = VM_heapRange(t, addr, len);
+      CHECK_HEAP_RANGE(t, a);
+
+      for (int i = 0; i < len; i++) a[i] *= k;
+      break;
+    }
+    case OP_AADD: {
+      CHECK_STACK_UNDERFLOW(t, 3);
+      int len = t->stack[t->sp--];
+      int src = t->stack[t->sp--];
+      int dst = t->stack[t->sp--];
+      int* s = VM_heapRange(t, src, len);
+      CHECK_HEAP_RANGE(t, s);
+      int* d = VM_heapRange(t, dst, len);
+      CHECK_HEAP_RANGE(t, d);
+
+      for (int i = 0; i < len; i++) d[i] += s[i];
+      break;
+    }
+    case OP_ADOT: {
+      CHECK_STACK_UNDERFLOW(t, 3);
+      int len    = t->stack[t->sp--];
+      int b_addr = t->stack[t->sp--];
+      int a_addr = t->stack[t->sp--];
+      int* a = VM_heapRange(t, a_addr, len);
+      CHECK_HEAP_RANGE(t, a);
+      int* b = VM_heapRange(t, b_addr, len);
+      CHECK_HEAP_RANGE(t, b);
+
+      int dot = 0;
+      for (int i = 0; i < len; i++) dot += a[i] * b[i];
+      t->stack[++t->sp] = dot;
+      break;
+    }
+    case OP_AHIST: {
+      CHECK_STACK_UNDERFLOW(t, 6);
+      int width = t->stack[t->sp--];
+      int lo    = t->stack[t->sp--];
+      int bins  = t->stack[t->sp--];
+      int dst   = t->stack[t->sp--];
+      int len   = t->stack[t->sp--];
+      int src   = t->stack[t->sp--];
+      if (bins <= 0 || width <= 0) {
+        Kernel_stdWrite(FD_STDERR, "Err: Bad histogram\n");
+        Kernel_terminateTask(t->id);
+        return;
+      }
+      int* s = VM_heapRange(t, src, len);
+      CHECK_HEAP_RANGE(t, s);
+      int* h = VM_heapRange(t, dst, bins);
+      CHECK_HEAP_RANGE(t, h);
+
+      // 구간: (v - lo) / width, 범위 밖은 양 끝 구간에 포함
+      for (int i = 0; i < bins; i++) h[i] = 0;
+      for (int i = 0; i < len; i++) {
+        long offset = (long)s[i] - lo;
+        int bin = (offset < 0) ? 0 : (int)(offset / width);
+        if (bin >= bins) bin = bins - 1;
+        h[bin]++;
+      }
+      break;
+    }
+    case OP_ACRC: {
+      CHECK_STACK_UNDERFLOW(t, 2);
+      int len  = t->stack[t->sp--];
+      int addr = t->stack[t->sp--];
+      int* a = VM_heapRange(t, addr, len);
+      CHECK_HEAP_RANGE(t, a);
+      CHECK_STACK_OVERFLOW(t);
+
+      // 각 원소를 16비트 Little Endian 2바이트로 취급 (StreamProtocol CRC32)
+      uint32_t crc = 0xFFFFFFFFUL;
+      for (int i = 0; i < len; i++) {
+        uint8_t le[2] = { (uint8_t)(a[i] & 0xFF), (uint8_t)((a[i] >> 8) & 0xFF) };
+        crc = sp_crc32_update(crc, le, 2);
+      }
+      crc = ~crc;
+      t->stack[++t->sp] = (int)(crc & 0xFFFF);
+      t->stack[++t->sp] = (int)(crc >> 16);
+      break;
+    }
+  }
+  VM_retryIfBlocked(t);
+}
+
+// ------------------------------------------------
+// v2 VM 메인 루프 (레지스터 기반)
+// ------------------------------------------------
+// 레지스터 번호는 니블(4비트)로 인코딩되며, 마스크로 범위를 보장합니다.
+#define REG_MASK (VM_REG_COUNT - 1)
+#define RD(rr) t->regs[((rr) >> 4) & REG_MASK]
+#define RA(rr) t->regs[(rr) & REG_MASK]
+
+void VM_runStepReg(Task* t) {
+  uint8_t opcode = VM_fetchByte(t);
+
+  if (!t->isActive()) return;
+  t->stats.instructions++;
+  if (t->sp >= t->stack_hwm) t->stack_hwm = t->sp + 1;
+  VM_markRetry(t);
+
+  switch (opcode) {
+    // --- 연산 ---
+    case ROP_MOVI: {
+      uint8_t rr = VM_fetchByte(t);
+      RD(rr) = VM_fetchInt(t);
+      break;
+    }
+    case ROP_MOV: {
+      uint8_t rr = VM_fetchByte(t);
+      RD(rr) = RA(rr);
+      break;
+    }
+    case ROP_ADD: {
+      uint8_t rr = VM_fetchByte(t);
+      uint8_t rb = VM_fetchByte(t);
+      RD(rr) = RA(rr) + RA(rb);
+      break;
+    }
+    case ROP_SUB: {
+      uint8_t rr = VM_fetchByte(t);
+      uint8_t rb = VM_fetchByte(t);
+      RD(rr) = RA(rr) - RA(rb);
+      break;
+    }
+    case ROP_EQ: {
+      uint8_t rr = VM_fetchByte(t);
+      uint8_t rb = VM_fetchByte(t);
+      RD(rr) = (RA(rr) == RA(rb)) ? 1 : 0;
+      break;
+    }
+    case ROP_ADDI: {
+      uint8_t rr = VM_fetchByte(t);
+      int imm = VM_fetchInt(t);
+      RD(rr) = RA(rr) + imm;
+      break;
+    }
+    case ROP_PUSH: {
+      CHECK_STACK_OVERFLOW(t);
+      uint8_t rr = VM_fetchByte(t);
+      t->stack[++t->sp] = RD(rr);
+      break;
+    }
+    case ROP_POP: {
+      CHECK_STACK_UNDERFLOW(t, 1);
+      uint8_t rr = VM_fetchByte(t);
+      RD(rr) = t->stack[t->sp--];
+      break;
+    }
+
+    // --- 제어 흐름 ---
+    case ROP_JMP: {
+      int target = VM_fetchInt(t);
+      Kernel_jump(t, target);
+      break;
+    }
+    case ROP_JNZ:
+    case ROP_JZ: {
+      uint8_t rr = VM_fetchByte(t);
+      int target = VM_fetchInt(t);
+      bool nonzero = (RD(rr) != 0);
+      if (nonzero == (opcode == ROP_JNZ)) {
+        Kernel_jump(t, target);
+      }
+      break;
+    }
+
+    // --- 입출력 ---
+    case ROP_PRINT: {
+      uint8_t rr = VM_fetchByte(t);
+      Kernel_stdWrite(FD_STDOUT, RD(rr));
+      Kernel_stdWriteChar(FD_STDOUT, '\n');
+      break;
+    }
+    case ROP_PRTC: {
+      uint8_t rr = VM_fetchByte(t);
+      Kernel_stdWriteChar(FD_STDOUT, (char)RD(rr));
+      break;
+    }
+    case ROP_PRTE: {
+      uint8_t rr = VM_fetchByte(t);
+      Kernel_stdWrite(FD_STDERR, RD(rr));
+      Kernel_stdWriteChar(FD_STDERR, '\n');
+      break;
+    }
+    case ROP_PRTS: {
+      uint8_t rr = VM_fetchByte(t);
+      int phys_addr = Kernel_getPhysAddr(t, RD(rr));
+
+      char temp_string_buffer[128];
+      int i = 0;
+      while (phys_addr >= 0 && phys_addr < GLOBAL_HEAP_SIZE && i < sizeof(temp_string_buffer) - 1) {
+        int val = global_heap[phys_addr];
+        if (val == 0) break;
+        temp_string_buffer[i++] = (char)val;
+        phys_addr++;
+      }
+      temp_string_buffer[i] = 0;
+
+      Kernel_stdWrite(FD_STDOUT, temp_string_buffer);
+      break;
+    }
+    case ROP_PRTR: {
+      int off = VM_fetchInt(t);
+      CHECK_RODATA(t, VM_printRodata(t, FD_STDOUT, off));
+      break;
+    }
+    case ROP_READ: {
+      uint8_t rr = VM_fetchByte(t);
+      int val = Kernel_stdRead(FD_STDIN);
+      RD(rr) = (val != -1) ? val : 0;
+      break;
+    }
+
+    // --- 시스템 ---
+    case ROP_SYS: {
+      int sys_id = VM_fetchInt(t);
+      Kernel_systemCall(t, sys_id);
+      break;
+    }
+    case ROP_NATIVE: {
+      int native_id = VM_fetchInt(t);
+      Native_call(t, native_id);
+      break;
+    }
+    case ROP_SLEEP: {
+      uint8_t rr = VM_fetchByte(t);
+      t->wake_up_time = RD(rr);
+      Kernel_yield(t);
+      break;
+    }
+    case ROP_EXIT: {
+      Kernel_terminateTask(t->id);
+      break;
+    }
+
+    // --- 메모리 ---
+    case ROP_MALLOC: {
+      uint8_t rr = VM_fetchByte(t);
+      int addr = Kernel_malloc(t, RA(rr));
+      RD(rr) = (addr == -1) ? 0 : addr;
+      break;
+    }
+    case ROP_LOAD: {
+      uint8_t rr = VM_fetchByte(t);
+      int imm = VM_fetchInt(t);
+      int addr = RA(rr) + imm;
+
+      if (!VM_loadCell(t, addr, &RD(rr))) {
+        Kernel_stdWrite(FD_STDERR, "SegFault: Read ");
+        Kernel_stdWrite(FD_STDERR, addr);
+        Kernel_stdWrite(FD_STDERR, "\n");
+        Kernel_terminateTask(t->id);
+      }
+      break;
+    }
+    case ROP_STORE: {
+      uint8_t rr = VM_fetchByte(t);
+      int imm = VM_fetchInt(t);
+      int addr = RA(rr) + imm;
+
+      if (!VM_storeCell(t, addr, RD(rr))) {
         Kernel_stdWrite(FD_STDERR, "SegFault: Write Addr ");
-        Kernel_stdWrite(FD_STDERR, phys_addr);
+        Kernel_stdWrite(FD_STDERR, addr);
         Kernel_stdWriteChar(FD_STDERR, '\n');
         Kernel_terminateTask(t->id);
       }
       break;
     }
+
+    case ROP_RCOPY: {
+      uint8_t rr = VM_fetchByte(t);
+      int off = VM_fetchInt(t);
+      CHECK_RODATA(t, VM_copyRodata(t, RD(rr), off, RA(rr)));
+      break;
+    }
+
+    default: {
+      Kernel_stdWrite(FD_STDERR, "Err: Bad opcode ");
+      Kernel_stdWrite(FD_STDERR, (int)opcode);
+      Kernel_stdWriteChar(FD_STDERR, '\n');
+      Kernel_terminateTask(t->id);
+      break;
+    }
   }
-}
\ No newline at end of file
+  VM_retryIfBlocked(t);
+}
@@ -10,8 +10,13 @@ int  Kernel_stdRead(int fd);
 void Kernel_systemCall(Task* t, int sys_id);
 void Kernel_yield(Task* t); // OP_SLEEP에서 사용
 
+// 가상 주소 범위 [addr, addr+len) -> 물리 포인터 (힙/공유 세그먼트 밖이거나 걸치면 NULL)
+// 배열 명령과 버퍼를 받는 시스템 콜이 함께 씀
+int* VM_heapRange(Task* t, int addr, int len);
+
 // VM 메인 함수
-void VM_runStep(Task* t);
+void VM_runStep(Task* t);    // v1: 스택 기반
+void VM_runStepReg(Task* t); // v2: 레지스터 기반
 
 #endif
 
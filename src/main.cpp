@@ -2,6 +2,8 @@
 #include "OSConfig.h"
 #include "HAL.h"
 #include "Kernel.h"
+#include "Ckpt.h"
+#include <FreeStack.h>
 
 // -----------------------------------------------------------------
 // [ArduOS Main Entry]
@@ -9,6 +11,9 @@
 // -----------------------------------------------------------------
 
 void setup() {
+  // 0. C 스택 영역을 패턴(0x55)으로 칠해둠 -> CMD_MEMINFO 에서 최대 사용량 측정
+  FillStack();
+
   // 1. 하드웨어(LCD, SD, Serial) 초기화
   HAL_init();
   
@@ -18,6 +23,11 @@ void setup() {
   // 2. 커널 초기화 (메모리, 태스크 테이블 등)
   Kernel_init();
 
+#if CKPT_AUTORESUME
+  // 2-1. 체크포인트 자동 재개 (CKPT_DIR 의 파일마다 초기화 없이 이어서 실행)
+  Ckpt_resumeAll();
+#endif
+
   // 3. 쉘(Shell) 프로그램 로딩 -> [삭제] 통신 데몬(Task 0) 사용을 위해 로드하지 않음
   // Kernel_loadTask(0, "shell.bin", NULL, NULL, NULL); // parent_arg_str = NULL
   
@@ -3,6 +3,9 @@
 
 #include "Kernel.h"
 #include "HAL.h"
+#include "Dentry.h"
+#include "Tmpfs.h"
+#include "SysHeap.h"
 
 // [SysCall 3] cd (디렉터리 이동)
 // Stack Args: [BufferAddr, PathAddr] (Pop: PathAddr, BufferAddr)
@@ -16,19 +19,9 @@ inline void Syscall_chdir(Task* t) {
     return;
   }
 
-  // 2. 힙에서 경로 문자열 읽기
-  char path_str[32]; 
-  memset(path_str, 0, 32);
-  
-  // 가상 -> 물리 변환
-  int phys_arg_addr = Kernel_getPhysAddr(t, arg_addr);
-
-  for (int i = 0; i < 31; i++) {
-    if (phys_arg_addr + i >= GLOBAL_HEAP_SIZE) break;
-    int val = global_heap[phys_arg_addr + i];
-    if (val == 0) break;
-    path_str[i] = (char)val;
-  }
+  // 2. 힙에서 경로 문자열 읽기 (가상 -> 물리 변환 포함)
+  char path_str[32];
+  Syscall_heapString(t, arg_addr, path_str, sizeof(path_str));
   
   // ---------------------------------------------------------
   // [로직] 경로 계산 ('..' 처리)
@@ -76,51 +69,35 @@ inline void Syscall_chdir(Task* t) {
   // ---------------------------------------------------------
   // [이동 실행]
   // ---------------------------------------------------------
-  // 실제 디렉터리가 존재하는지 확인 (SD 라이브러리 사용)
+  // 실제 디렉터리가 존재하는지 확인 (dentry 캐시, 적중 시 SD 접근 없음)
   // 주의: target_path가 "/"인 경우는 항상 성공
-  bool success = false;
-  if (strcmp(target_path, "/") == 0) {
-      success = true;
-  } else {
-      File32 dir = sd.open(target_path);
-      if (dir && dir.isDirectory()) {
-          success = true;
-          dir.close();
-      }
-  }
+  bool is_dir = false;
+  uint16_t size;
+  bool success = (Tmpfs_isPath(target_path) ? Tmpfs_stat(target_path, &is_dir, &size)
+                                            : Dentry_stat(target_path, &is_dir)) && is_dir;
 
   if (success) {
-      // 성공! cwd 갱신
-      memset(t->cwd, 0, 32);
-      strncpy(t->cwd, target_path, 31);
-      
       // cwd가 '/'로 끝나지 않고 루트도 아니면 뒤에 '/' 붙여줌 (보기 좋게)
-      int len = strlen(t->cwd);
-      if (len > 1 && t->cwd[len-1] != '/') {
-          strcat(t->cwd, "/");
+      char new_cwd[32];
+      memset(new_cwd, 0, 32);
+      strncpy(new_cwd, target_path, 30);
+      int len = strlen(new_cwd);
+      if (len > 1 && new_cwd[len-1] != '/') {
+          strcat(new_cwd, "/");
       }
-      
+
+      // 성공! cwd 갱신 (인터닝 문자열 교체, 풀이 가득 차면 실패 처리)
+      success = Kernel_setCwd(t, new_cwd);
+  }
+
+  if (success) {
       // [신규] 변경된 경로를 사용자 버퍼에 복사 (피드백)
-      if (buf_addr != 0) {
-          int phys_buf_addr = Kernel_getPhysAddr(t, buf_addr);
-          int new_len = strlen(t->cwd);
-          for(int i=0; i < new_len; i++) {
-              if (phys_buf_addr + i < GLOBAL_HEAP_SIZE) {
-                  global_heap[phys_buf_addr + i] = t->cwd[i];
-              }
-          }
-          // NULL Terminate
-          if (phys_buf_addr + new_len < GLOBAL_HEAP_SIZE) {
-              global_heap[phys_buf_addr + new_len] = 0;
-          }
-      }
+      if (buf_addr != 0) Syscall_putHeapString(t, buf_addr, t->cwd);
 
   } else {
       // 실패 시 결과 버퍼에 -1 기록
-      if (buf_addr != 0) {
-           int phys_buf = Kernel_getPhysAddr(t, buf_addr);
-           if (phys_buf < GLOBAL_HEAP_SIZE) global_heap[phys_buf] = -1;
-      }
+      int* buf = (buf_addr != 0) ? VM_heapRange(t, buf_addr, 1) : NULL;
+      if (buf != NULL) *buf = -1;
   }
 }
 
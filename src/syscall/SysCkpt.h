@@ -0,0 +1,60 @@
+#ifndef SYS_CKPT_H
+#define SYS_CKPT_H
+
+#include "Kernel.h"
+#include "Ckpt.h"
+#include "SysHeap.h"
+
+// [SysCall 50] checkpoint - 태스크 상태를 파일로 저장 (Ckpt.h)
+// Stack Args: [TaskId, PathAddr, Stop] -> Push: [0=저장함, 1=이 체크포인트에서 재개됨, -1=실패]
+// TaskId = -1 이면 자기 자신, 아니면 SLEEP 중이거나 실행 대기 중인 다른 태스크 (자식 대기/막힘 상태는 불가)
+// Stop = 1 이면 저장 후 그 태스크를 끝냄 (hibernate, 자기 자신이면 결과도 넣지 않음)
+// 자기 자신을 저장하면 재개된 쪽은 같은 SYS 뒤에서 1 을 받으므로 초기화 단계를 건너뛸 수 있음
+inline void Syscall_checkpoint(Task* t) {
+  int stop = t->stack[t->sp--];
+  int path_addr = t->stack[t->sp--];
+  int task_id = t->stack[t->sp--];
+
+  Task* target = t;
+  if (task_id != -1) {
+    target = (task_id > 0 && task_id < TASK_COUNT) ? tasks[task_id] : NULL;
+    if (target == NULL || !target->isRunnable()) { // 자식 대기/막힘은 되살릴 수 없는 상태
+      t->stack[++t->sp] = -1;
+      return;
+    }
+  }
+
+  char path_str[32];
+  char target_path[64];
+  Syscall_heapString(t, path_addr, path_str, sizeof(path_str));
+  resolve_path(t, path_str, target_path);
+
+  bool ok;
+  if (target == t) {
+    t->stack[++t->sp] = 1; // 재개된 태스크가 받을 결과를 넣은 채로 저장
+    ok = Ckpt_save(t, target_path);
+    t->sp--;
+  } else {
+    ok = Ckpt_save(target, target_path);
+  }
+
+  if (ok && stop == 1) {
+    Kernel_terminateTask(target->id);
+    if (target == t) return;
+  }
+  t->stack[++t->sp] = ok ? 0 : -1;
+}
+
+// [SysCall 51] resume - 체크포인트를 빈 슬롯에 되살림 (부모 = 호출한 태스크)
+// Stack Args: [PathAddr] -> Push: [태스크 ID, -1=실패]
+inline void Syscall_resume(Task* t) {
+  int path_addr = t->stack[t->sp--];
+
+  char path_str[32];
+  char target_path[64];
+  Syscall_heapString(t, path_addr, path_str, sizeof(path_str));
+  resolve_path(t, path_str, target_path);
+  t->stack[++t->sp] = Ckpt_resume(target_path, t->id);
+}
+
+#endif
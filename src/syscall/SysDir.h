@@ -0,0 +1,129 @@
+#ifndef SYS_DIR_H
+#define SYS_DIR_H
+
+#include "Kernel.h"
+#include "HAL.h"
+#include "Dentry.h"
+#include "KFile.h"
+#include "Tmpfs.h"
+#include "SysHeap.h"
+
+// -----------------------------------------------------------------
+// [SysCall 10~12] 디렉터리 커서 (opendir / readdir / closedir)
+// ls 와 달리 목록 전체를 버퍼에 담지 않고 항목을 하나씩 꺼내므로
+// 디렉터리 크기와 상관없이 힙 사용량이 일정합니다.
+// 핸들은 커널 파일 핸들 풀(KFile)의 번호 (RAM 디스크면 tmpfs 핸들)이며 태스크 종료 시 자동으로 닫힙니다.
+// -----------------------------------------------------------------
+
+// readdir 가 채우는 항목 레이아웃 (int 단위)
+// [0] 속성 (DIRENT_ATTR_*), [1] 크기 하위 16비트, [2] 크기 상위 16비트, [3~] 이름 (NULL 종료)
+#define DIRENT_ATTR_DIR      0x01
+#define DIRENT_ATTR_READONLY 0x02
+#define DIRENT_ATTR_HIDDEN   0x04
+#define DIRENT_NAME_MAX      32   // NULL 포함
+#define DIRENT_INTS          (3 + DIRENT_NAME_MAX)
+
+// [SysCall 10] opendir - 디렉터리 커서 열기
+// Stack Args: [PathAddr] (0이면 CWD) -> Push: [DirHandle] (실패 시 -1)
+inline void Syscall_opendir(Task* t) {
+  int path_addr = t->stack[t->sp--];
+
+  char target_path[64];
+  if (path_addr == 0) {
+    strcpy(target_path, t->cwd);
+  } else {
+    char path_str[32];
+    Syscall_heapString(t, path_addr, path_str, sizeof(path_str));
+    resolve_path(t, path_str, target_path);
+  }
+
+  if (Tmpfs_isPath(target_path)) {
+    t->stack[++t->sp] = Tmpfs_opendir(t->id, target_path);
+    return;
+  }
+
+  int8_t h = KFile_alloc(t->id);
+  File32* dir = KFile_get(h, t->id);
+  if (dir == NULL || !Dentry_open(target_path, dir) || !dir->isDir()) {
+    KFile_free(h);
+    h = KFILE_NONE;
+  }
+  t->stack[++t->sp] = h;
+}
+
+// [SysCall 11] readdir - 다음 항목 하나를 EntAddr 에 기록 (FatFile::openNext)
+// Stack Args: [EntAddr, DirHandle] (Pop: DirHandle, EntAddr)
+// Push: [1=항목 기록, 0=끝, -1=잘못된 핸들/주소 (커서는 그대로)]
+inline void Syscall_readdir(Task* t) {
+  int8_t h = (int8_t)t->stack[t->sp--];
+  int ent_addr = t->stack[t->sp--];
+
+  // 항목을 꺼내기 전에 주소부터 확인 (잘못된 주소로 커서만 앞으로 가 항목을 잃지 않도록)
+  int* ent = VM_heapRange(t, ent_addr, DIRENT_INTS);
+  if (ent == NULL) {
+    t->stack[++t->sp] = -1;
+    return;
+  }
+
+  char name[DIRENT_NAME_MAX];
+  memset(name, 0, sizeof(name));
+  int attr = 0;
+  uint32_t size;
+
+  if (Tmpfs_isEnd(h)) {
+    uint16_t tsize = 0;
+    int r = Tmpfs_valid(h, t->id) ? Tmpfs_readdir(h, name, sizeof(name), &tsize) : -1;
+    if (r != 1) {
+      t->stack[++t->sp] = r;
+      return;
+    }
+    size = tsize;
+  } else {
+    File32* dir = KFile_get(h, t->id);
+    if (dir == NULL) {
+      t->stack[++t->sp] = -1;
+      return;
+    }
+
+    File32 entry;
+    if (!entry.openNext(dir, O_RDONLY)) {
+      t->stack[++t->sp] = 0;
+      return;
+    }
+
+    entry.getName(name, sizeof(name));
+    if (entry.isDir()) attr |= DIRENT_ATTR_DIR;
+    if (entry.isReadOnly()) attr |= DIRENT_ATTR_READONLY;
+    if (entry.isHidden()) attr |= DIRENT_ATTR_HIDDEN;
+    size = entry.fileSize();
+    entry.close();
+  }
+
+  ent[0] = attr;
+  ent[1] = (int)(size & 0xFFFF);
+  ent[2] = (int)(size >> 16);
+  int k = 0;
+  for (; name[k] != 0; k++) ent[3 + k] = name[k];
+  ent[3 + k] = 0;
+
+  t->stack[++t->sp] = 1;
+}
+
+// [SysCall 12] closedir - 커서 닫기
+// Stack Args: [DirHandle] -> Push: [0=성공, -1=잘못된 핸들]
+inline void Syscall_closedir(Task* t) {
+  int8_t h = (int8_t)t->stack[t->sp--];
+  if (Tmpfs_valid(h, t->id)) {
+    Tmpfs_close(h);
+    t->stack[++t->sp] = 0;
+    return;
+  }
+  if (KFile_get(h, t->id) == NULL) {
+    t->stack[++t->sp] = -1;
+    return;
+  }
+  KFile_free(h);
+  t->stack[++t->sp] = 0;
+}
+
+#endif
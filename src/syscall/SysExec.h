@@ -3,10 +3,102 @@
 
 #include "Kernel.h"
 #include "HAL.h"
+#include "Redirect.h"
+#include "KFile.h"
+#include "Pipe.h"
+#include "Tmpfs.h"
+#include "SysHeap.h"
+
+// [리다이렉트 파싱] 인자 문자열에서 리다이렉트를 떼어냄 (out[fd], fd = 0/1/2)
+//   "> 파일", ">> 파일", "2> 파일", "2>> 파일" : 자식 stdout/stderr -> 파일
+//   "<&N", ">&N", "2>&N"                     : 자식 stdin/stdout/stderr <- 부모의 fd N (파이프 끝)
+struct ExecRedirect {
+  char path[32];  // path[0] == 0 이면 파일 리다이렉트 없음
+  bool append;
+  int8_t dup;     // 부모 fd 번호 (-1 이면 없음)
+};
+
+inline void Syscall_takeRedirects(char* args, ExecRedirect* out) {
+  char* r = args;
+  char* w = args;
+  char prev = ' ';
+  while (*r) {
+    int fd = -1;
+    char* p = r;
+    if (prev == ' ' && p[0] == '2' && p[1] == '>') { fd = FD_STDERR; p++; }
+    else if (prev == ' ' && p[0] == '>') fd = FD_STDOUT;
+    else if (prev == ' ' && p[0] == '<' && p[1] == '&') fd = FD_STDIN;
+    if (fd == -1) {
+      prev = *r;
+      *w++ = *r++;
+      continue;
+    }
+
+    p++; // '>' / '<'
+    ExecRedirect* rd = &out[fd];
+    if (*p == '&') {
+      p++;
+      rd->dup = 0;
+      while (*p >= '0' && *p <= '9') rd->dup = rd->dup * 10 + (*p++ - '0');
+    } else {
+      rd->append = (*p == '>');
+      if (rd->append) p++;
+      while (*p == ' ') p++;
+      int n = 0;
+      while (*p && *p != ' ') {
+        if (n < 31) rd->path[n++] = *p;
+        p++;
+      }
+      rd->path[n] = '\0';
+    }
+    while (*p && *p != ' ') p++;
+    r = p;
+    prev = ' ';
+  }
+  while (w > args && w[-1] == ' ') w--; // 떼어낸 뒤 남은 앞뒤 공백 제거
+  *w = '\0';
+  char* start = args;
+  while (*start == ' ') start++;
+  if (start != args) memmove(args, start, strlen(start) + 1);
+}
+
+// 자식 fd 에 리다이렉트 연결 (실패 시 에러 출력 후 false)
+inline bool Syscall_applyRedirect(Task* parent, Task* child, int fd, const ExecRedirect* rd) {
+  if (rd->dup >= 0) {
+    int8_t v = (rd->dup < TASK_FDS) ? parent->fds[rd->dup] : KFILE_NONE;
+    if (!Pipe_isEnd(v)) { // 파일 핸들은 태스크 소유라 공유할 수 없음
+      HAL_write(FD_STDERR, "Error: not a pipe fd\n");
+      return false;
+    }
+    Pipe_ref(v);
+    child->fds[fd] = v;
+    return true;
+  }
+  if (rd->path[0] == '\0') return true;
+
+  char abs_path[64];
+  resolve_path(parent, rd->path, abs_path);
+  bool ok;
+  if (Tmpfs_isPath(abs_path)) { // RAM 디스크는 섹터 버퍼 없이 바로 씀
+    int8_t v = Tmpfs_open(child->id, abs_path, O_WRONLY | O_CREAT | (rd->append ? O_APPEND : O_TRUNC));
+    if (v != -1) child->fds[fd] = v;
+    ok = (v != -1);
+  } else {
+    ok = Redirect_open(child, fd, abs_path, rd->append);
+  }
+  if (!ok) {
+    HAL_write(FD_STDERR, "Error: cannot open ");
+    HAL_write(FD_STDERR, abs_path);
+    HAL_write(FD_STDERR, "\n");
+    return false;
+  }
+  return true;
+}
 
 // [SysCall 2] exec - 새 태스크 실행
 // Stack Args: [WaitOption, CmdAddr, ArgAddr] (Pop 순서: ArgAddr, CmdAddr, WaitOption)
 // WaitOption: 1=Sync(Wait), 0=Async
+// Arg 의 리다이렉트 ("> 파일", "2> 파일", "<&N", ">&N" 등)는 떼어내 자식 fd 에 연결 (Syscall_takeRedirects)
 inline void Syscall_exec(Task* t) {
   // 1. 스택에서 주소 꺼내기
   // 주의: 스택은 LIFO이므로, 나중에 PUSH한 것이 먼저 나옴.
@@ -16,37 +108,27 @@ inline void Syscall_exec(Task* t) {
   int cmd_addr = t->stack[t->sp--];
   int arg_addr = t->stack[t->sp--];
   
-  // [주소 변환] 가상 주소를 물리 주소로 변환
-  cmd_addr = Kernel_getPhysAddr(t, cmd_addr);
-  if (arg_addr != 0) arg_addr = Kernel_getPhysAddr(t, arg_addr);
-
-  // 2. cmd 문자열 (파일 이름) 읽기
+  // 2. cmd 문자열 (파일 이름) 읽기 (가상 주소 변환은 Syscall_heapString 이 함, 공백에서 끊음)
   char cmd_str[32];
-  memset(cmd_str, 0, sizeof(cmd_str));
-  for (int i = 0; i < 31; i++) {
-    if (cmd_addr + i >= GLOBAL_HEAP_SIZE) break;
-    int val = global_heap[cmd_addr + i];
-    if (val == 0 || val == ' ') break;
-    cmd_str[i] = (char)val;
-  }
+  Syscall_heapString(t, cmd_addr, cmd_str, sizeof(cmd_str));
+  char* space = strchr(cmd_str, ' ');
+  if (space != NULL) *space = '\0';
 
-  // 3. arg 문자열 (옵션 인자) 읽기 (주소가 0이 아닐 때만)
-  char arg_str[32];
+  // 3. arg 문자열 (옵션 인자) 읽기 (주소가 0이 아닐 때만, 리다이렉트 포함이라 넉넉히)
+  char arg_str[64];
   memset(arg_str, 0, sizeof(arg_str));
-  if (arg_addr != 0) {
-    for (int i = 0; i < 31; i++) {
-      if (arg_addr + i >= GLOBAL_HEAP_SIZE) break;
-      int val = global_heap[arg_addr + i];
-      if (val == 0) break;
-      arg_str[i] = (char)val;
-    }
-  }
+  if (arg_addr != 0) Syscall_heapString(t, arg_addr, arg_str, sizeof(arg_str));
+
+  ExecRedirect redirects[3];
+  memset(redirects, 0, sizeof(redirects));
+  for (int i = 0; i < 3; i++) redirects[i].dup = -1;
+  Syscall_takeRedirects(arg_str, redirects);
 
   // 4. 빈 태스크 슬롯 찾기 (0번은 쉘이므로 1번부터)
   int free_slot = -1;
   for (int i = 1; i < TASK_COUNT; i++) {
-    // if (!tasks[i].is_active) { -> [수정] isActive() 대신 setFree() 상태 확인
-    if (tasks[i].task_state == TASK_FREE) {
+    // if (!tasks[i]->is_active) { -> [수정] isActive() 대신 setFree() 상태 확인
+    if (tasks[i]->task_state == TASK_FREE) {
       free_slot = i;
       break;
     }
@@ -56,9 +138,18 @@ inline void Syscall_exec(Task* t) {
   if (free_slot != -1) {
     // Kernel_loadTask(id, filename, args, parent_cwd, parent_arg_str)
     // [수정] 로딩 성공 여부 확인
-    bool success = Kernel_loadTask(free_slot, cmd_str, NULL, t->cwd, (arg_addr != 0) ? (const char*)arg_str : NULL); 
+    bool success = Kernel_loadTask(free_slot, cmd_str, NULL, t->cwd, (arg_str[0] != '\0') ? (const char*)arg_str : NULL); 
+
+    // 리다이렉트 연결 (자식은 아직 한 명령도 실행하지 않음)
+    for (int fd = FD_STDIN; success && fd <= FD_STDERR; fd++) {
+      if (!Syscall_applyRedirect(t, tasks[free_slot], fd, &redirects[fd])) {
+        Kernel_terminateTask(free_slot);
+        success = false;
+      }
+    }
     
     if (success) {
+        tasks[free_slot]->parent = t->id; // 메일박스 MBOX_PARENT 대상
         // [동기화 로직 추가]
         if (wait_opt == 1) {
             // 동기 실행: 부모는 자식을 기다림 (자식 ID를 상태 변수에 저장)
@@ -0,0 +1,288 @@
+#ifndef SYS_FILE_H
+#define SYS_FILE_H
+
+#include "Kernel.h"
+#include "HAL.h"
+#include "Dentry.h"
+#include "KFile.h"
+#include "Redirect.h"
+#include "Pipe.h"
+#include "Tmpfs.h"
+#include "SysHeap.h"
+
+// -----------------------------------------------------------------
+// [SysCall 20~25] 파일 입출력 (open / read / write / seek / close / unlink)
+// fd 는 태스크별 표(Task::fds)의 번호이고 실제 File32 는 커널 파일 핸들 풀(KFile)에 있습니다.
+// TMPFS_MOUNT 아래 경로는 RAM 디스크 핸들(Tmpfs)이 같은 표에 들어갑니다.
+// 0~2 는 표준 입출력 자리 (표가 비어 있으면 시리얼), open 은 3번부터 배정합니다.
+// read/write 는 (힙 주소, 길이) 블록을 한 번에 옮기며 힙은 int 하나에 1바이트입니다.
+// -----------------------------------------------------------------
+
+#define OPEN_READ    0  // 읽기 전용
+#define OPEN_WRITE   1  // 쓰기 (없으면 생성, 있으면 비움)
+#define OPEN_APPEND  2  // 이어 쓰기 (없으면 생성)
+#define OPEN_RDWR    3  // 읽기/쓰기 (없으면 생성)
+
+#define SEEK_FROM_START 0
+#define SEEK_FROM_CUR   1
+#define SEEK_FROM_END   2
+
+#define FILE_IO_CHUNK 32 // SD <-> 힙 복사용 임시 버퍼 (C 스택)
+
+// fd -> fds[] 값 (파이프 끝 판별용, 잘못된 fd 면 KFILE_NONE)
+inline int8_t Syscall_fdValue(Task* t, int fd) {
+  return (fd >= 0 && fd < TASK_FDS) ? t->fds[fd] : KFILE_NONE;
+}
+
+// fd -> open 으로 연 파일 (표준 입출력 자리나 잘못된 fd 면 NULL)
+// 리다이렉트된 fd 1/2 는 Redirect 버퍼를 거쳐야 하므로 여기서 돌려주지 않음
+inline File32* Syscall_fdFile(Task* t, int fd) {
+  if (fd <= FD_STDERR || fd >= TASK_FDS) return NULL;
+  return KFile_get(t->fds[fd], t->id);
+}
+
+// [SysCall 20] open
+// Stack Args: [PathAddr, Mode] (Pop: Mode, PathAddr) -> Push: [fd] (실패 시 -1)
+inline void Syscall_open(Task* t) {
+  int mode = t->stack[t->sp--];
+  int path_addr = t->stack[t->sp--];
+
+  // 1. 빈 fd 자리 찾기
+  int fd = -1;
+  for (int i = FD_STDERR + 1; i < TASK_FDS; i++) {
+    if (t->fds[i] == KFILE_NONE) { fd = i; break; }
+  }
+
+  oflag_t oflag;
+  switch (mode) {
+    case OPEN_READ:   oflag = O_RDONLY; break;
+    case OPEN_WRITE:  oflag = O_WRONLY | O_CREAT | O_TRUNC; break;
+    case OPEN_APPEND: oflag = O_WRONLY | O_CREAT | O_APPEND; break;
+    case OPEN_RDWR:   oflag = O_RDWR | O_CREAT; break;
+    default:          fd = -1; break;
+  }
+  if (fd == -1 || path_addr == 0) {
+    t->stack[++t->sp] = -1;
+    return;
+  }
+
+  // 2. 경로 읽기 -> 절대 경로
+  char path_str[32];
+  Syscall_heapString(t, path_addr, path_str, sizeof(path_str));
+  char target_path[64];
+  resolve_path(t, path_str, target_path);
+
+  // 3. RAM 디스크면 tmpfs 핸들, 아니면 커널 파일 핸들 풀에서 핸들을 빌려 열기
+  if (Tmpfs_isPath(target_path)) {
+    int8_t v = Tmpfs_open(t->id, target_path, oflag);
+    if (v != -1) t->fds[fd] = v;
+    t->stack[++t->sp] = (v != -1) ? fd : -1;
+    return;
+  }
+  int8_t h = KFile_alloc(t->id);
+  File32* f = KFile_get(h, t->id);
+  bool ok = (f != NULL) && Kernel_openFile(target_path, oflag, f);
+  if (!ok) {
+    KFile_free(h);
+    t->stack[++t->sp] = -1;
+    return;
+  }
+
+  t->fds[fd] = h;
+  t->stack[++t->sp] = fd;
+}
+
+// [SysCall 21] read - 최대 Len 바이트를 BufAddr 부터 힙에 기록
+// Stack Args: [BufAddr, Len, fd] (Pop: fd, Len, BufAddr) -> Push: [읽은 바이트 수] (오류 시 -1)
+// 표준 입력(fd 0, 시리얼)은 기다리지 않고 지금 도착한 만큼만 읽음
+// 파이프는 들어 있는 만큼 읽고, 비었으면 막힘 (쓰는 쪽이 모두 닫혔으면 0 = EOF)
+inline void Syscall_read(Task* t) {
+  int fd = t->stack[t->sp--];
+  int len = t->stack[t->sp--];
+  int buf_addr = t->stack[t->sp--];
+
+  int* heap = VM_heapRange(t, buf_addr, len);
+  if (heap == NULL) {
+    t->stack[++t->sp] = -1;
+    return;
+  }
+
+  int8_t v = Syscall_fdValue(t, fd);
+  if (Pipe_isEnd(v)) {
+    int n = Pipe_read(t, v, heap, len);
+    if (n != PIPE_BLOCK) t->stack[++t->sp] = n;
+    return;
+  }
+  if (Tmpfs_isEnd(v)) {
+    uint8_t buf[FILE_IO_CHUNK];
+    int total = 0;
+    while (total < len) {
+      int want = len - total;
+      if (want > FILE_IO_CHUNK) want = FILE_IO_CHUNK;
+      int n = Tmpfs_read(v, buf, want);
+      if (n < 0) { total = -1; break; }
+      for (int i = 0; i < n; i++) heap[total + i] = buf[i];
+      total += n;
+      if (n < want) break; // EOF
+    }
+    t->stack[++t->sp] = total;
+    return;
+  }
+
+  File32* f = Syscall_fdFile(t, fd);
+  int total = 0;
+  if (f == NULL) {
+    if (fd != FD_STDIN) {
+      t->stack[++t->sp] = -1;
+      return;
+    }
+    while (total < len) {
+      int c = Kernel_stdRead(FD_STDIN);
+      if (c == -1) break;
+      heap[total++] = c;
+    }
+  } else {
+    uint8_t buf[FILE_IO_CHUNK];
+    while (total < len) {
+      int want = len - total;
+      if (want > FILE_IO_CHUNK) want = FILE_IO_CHUNK;
+      int n = f->read(buf, want);
+      if (n <= 0) break;
+      for (int i = 0; i < n; i++) heap[total + i] = buf[i];
+      total += n;
+      if (n < want) break; // EOF
+    }
+  }
+  t->stack[++t->sp] = total;
+}
+
+// [SysCall 22] write - 힙의 Len 개 값(하위 8비트)을 기록
+// Stack Args: [BufAddr, Len, fd] (Pop: fd, Len, BufAddr) -> Push: [쓴 바이트 수] (오류 시 -1)
+// 표준 출력/에러는 리다이렉트 버퍼로, 없으면 조각마다 패킷 하나로 전송
+// 파이프는 전부 들어갈 자리가 생길 때까지 막힘 (PIPE_SIZE 보다 길면 들어가는 만큼, 읽는 쪽 없으면 -1)
+inline void Syscall_write(Task* t) {
+  int fd = t->stack[t->sp--];
+  int len = t->stack[t->sp--];
+  int buf_addr = t->stack[t->sp--];
+
+  int* heap = VM_heapRange(t, buf_addr, len);
+  int8_t v = Syscall_fdValue(t, fd);
+  if (Pipe_isEnd(v)) {
+    if (heap == NULL) {
+      t->stack[++t->sp] = -1;
+      return;
+    }
+    int n = Pipe_write(t, v, heap, len);
+    if (n != PIPE_BLOCK) t->stack[++t->sp] = n;
+    return;
+  }
+  bool to_tmp = Tmpfs_isEnd(v); // open 한 RAM 디스크 파일 또는 RAM 디스크로 리다이렉트된 fd 1/2
+  File32* f = to_tmp ? NULL : Syscall_fdFile(t, fd);
+  bool to_std = (f == NULL && (fd == FD_STDOUT || fd == FD_STDERR));
+  if (heap == NULL || (f == NULL && !to_std && !to_tmp)) {
+    t->stack[++t->sp] = -1;
+    return;
+  }
+
+  uint8_t buf[FILE_IO_CHUNK];
+  int total = 0;
+  while (total < len) {
+    int n = len - total;
+    if (n > FILE_IO_CHUNK) n = FILE_IO_CHUNK;
+    for (int i = 0; i < n; i++) buf[i] = (uint8_t)heap[total + i];
+
+    if (to_tmp) {
+      int w = Tmpfs_write(v, buf, n);
+      if (w < n) { total += (w > 0) ? w : 0; break; } // RAM 디스크 가득 참
+    } else if (to_std) {
+      if (!Redirect_write(t, fd, buf, n)) HAL_write(fd, buf, n); // 길이째 보냄 (0 바이트에서 잘리지 않음)
+    } else {
+      int w = f->write(buf, n);
+      if (w <= 0) break;
+      if (w < n) { total += w; break; } // 카드 가득 참 등
+    }
+    total += n;
+  }
+  t->stack[++t->sp] = total;
+}
+
+// [SysCall 23] seek
+// Stack Args: [Offset, Whence, fd] (Pop: fd, Whence, Offset) -> Push: [0=성공, -1=실패]
+// SEEK_FROM_START 의 Offset 은 부호 없는 16비트, 나머지는 부호 있는 값
+inline void Syscall_seek(Task* t) {
+  int fd = t->stack[t->sp--];
+  int whence = t->stack[t->sp--];
+  int offset = t->stack[t->sp--];
+
+  int8_t v = Syscall_fdValue(t, fd);
+  File32* f = Syscall_fdFile(t, fd);
+  bool ok = false;
+  if (Tmpfs_isEnd(v)) {
+    long pos = (whence == SEEK_FROM_START) ? (long)(uint16_t)offset
+             : (whence == SEEK_FROM_CUR) ? (long)Tmpfs_tell(v) + offset
+             : (whence == SEEK_FROM_END) ? (long)Tmpfs_size(v) + offset : -1;
+    ok = pos >= 0 && pos <= 0xFFFF && Tmpfs_seek(v, (uint16_t)pos);
+  } else if (f != NULL) {
+    if (whence == SEEK_FROM_START) ok = f->seekSet((uint16_t)offset);
+    else if (whence == SEEK_FROM_CUR) ok = f->seekCur(offset);
+    else if (whence == SEEK_FROM_END) ok = f->seekEnd(offset);
+  }
+  t->stack[++t->sp] = ok ? 0 : -1;
+}
+
+// [SysCall 24] close (리다이렉트된 fd 1/2 도 닫을 수 있음 -> 이후 시리얼)
+// Stack Args: [fd] -> Push: [0=성공, -1=잘못된 fd]
+inline void Syscall_close(Task* t) {
+  int fd = t->stack[t->sp--];
+  if (Pipe_isEnd(Syscall_fdValue(t, fd))) {
+    Pipe_unref(t->fds[fd]);
+    t->fds[fd] = KFILE_NONE;
+    t->stack[++t->sp] = 0;
+    return;
+  }
+  if (Tmpfs_isEnd(Syscall_fdValue(t, fd))) {
+    Tmpfs_close(t->fds[fd]);
+    t->fds[fd] = KFILE_NONE;
+    t->stack[++t->sp] = 0;
+    return;
+  }
+  if (Redirect_close(t, fd)) {
+    t->stack[++t->sp] = 0;
+    return;
+  }
+  if (Syscall_fdFile(t, fd) == NULL) {
+    t->stack[++t->sp] = -1;
+    return;
+  }
+  KFile_free(t->fds[fd]);
+  t->fds[fd] = KFILE_NONE;
+  t->stack[++t->sp] = 0;
+}
+
+// [SysCall 25] unlink - 파일 삭제 (SD 또는 RAM 디스크, 디렉터리는 불가)
+// Stack Args: [PathAddr] -> Push: [0=성공, -1=실패 (없음/디렉터리/열려 있음)]
+inline void Syscall_unlink(Task* t) {
+  int path_addr = t->stack[t->sp--];
+
+  char path_str[32];
+  Syscall_heapString(t, path_addr, path_str, sizeof(path_str));
+  char target_path[64];
+  resolve_path(t, path_str, target_path);
+
+  bool ok;
+  if (Tmpfs_isPath(target_path)) {
+    ok = Tmpfs_unlink(target_path);
+  } else {
+    File32 f;
+    ok = path_str[0] != '\0' && Kernel_openFile(target_path, O_RDWR, &f);
+    // 열려 있는 파일은 지울 수 없음 (Tmpfs_unlink 와 같음): 지우면 핸들이 풀린 클러스터를 가리킴
+    if (ok && (Kernel_isFileBusy(&f) || !f.remove())) {
+      f.close();
+      ok = false;
+    }
+    if (ok) Kernel_onFsWrite(target_path); // 경로 캐시에서 빼기
+  }
+  t->stack[++t->sp] = ok ? 0 : -1;
+}
+
+#endif
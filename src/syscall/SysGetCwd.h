@@ -3,6 +3,7 @@
 
 #include "Kernel.h"
 #include "HAL.h"
+#include "SysHeap.h"
 
 // [SysCall 4] getcwd - 현재 작업 디렉터리 경로 반환
 // Stack Args: [BufferAddr] (Pop: BufferAddr)
@@ -11,18 +12,7 @@ inline void Syscall_getcwd(Task* t) {
   
   if (buf_addr == 0) return; // 버퍼 없으면 무시
 
-  int phys_buf_addr = Kernel_getPhysAddr(t, buf_addr);
-  int len = strlen(t->cwd);
-
-  for(int i=0; i < len; i++) {
-      if (phys_buf_addr + i < GLOBAL_HEAP_SIZE) {
-          global_heap[phys_buf_addr + i] = t->cwd[i];
-      }
-  }
-  // NULL Terminate
-  if (phys_buf_addr + len < GLOBAL_HEAP_SIZE) {
-      global_heap[phys_buf_addr + len] = 0;
-  }
+  Syscall_putHeapString(t, buf_addr, t->cwd); // 힙 밖이거나 모자라면 쓰지 않음
 }
 
 #endif
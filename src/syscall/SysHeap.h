@@ -0,0 +1,34 @@
+#ifndef SYS_HEAP_H
+#define SYS_HEAP_H
+
+#include "Kernel.h"
+#include "VirtualMachine.h"
+
+// -----------------------------------------------------------------
+// [시스템 콜 문자열 인자] 태스크 가상 주소의 문자열을 읽고 쓰는 공용 도우미
+// Kernel_getPhysAddr 가 -1 (스왑된 세그먼트, 파일 매핑 창, 붙이지 않은 공유 창) 이면
+// 읽기는 빈 문자열, 쓰기는 false 로 끝나며 global_heap 밖을 건드리지 않습니다.
+// -----------------------------------------------------------------
+
+// 힙 문자열 -> C 문자열 (NULL 또는 cap-1 글자까지)
+inline void Syscall_heapString(Task* t, int addr, char* out, int cap) {
+  int phys = Kernel_getPhysAddr(t, addr);
+  int i = 0;
+  for (; phys >= 0 && i < cap - 1 && phys + i < GLOBAL_HEAP_SIZE; i++) {
+    int val = global_heap[phys + i];
+    if (val == 0) break;
+    out[i] = (char)val;
+  }
+  out[i] = '\0';
+}
+
+// C 문자열 -> 힙 (NULL 까지 모두 들어갈 때만 씀)
+inline bool Syscall_putHeapString(Task* t, int addr, const char* s) {
+  int len = strlen(s);
+  int* p = VM_heapRange(t, addr, len + 1);
+  if (p == NULL) return false;
+  for (int i = 0; i <= len; i++) p[i] = s[i];
+  return true;
+}
+
+#endif
@@ -3,6 +3,31 @@
 
 #include "Kernel.h"
 #include "HAL.h"
+#include "Dentry.h"
+#include "KFile.h"
+#include "Tmpfs.h"
+#include "VirtualMachine.h"
+
+// 이름 한 줄 ("name\n") 을 힙 버퍼에 덧붙임 (NULL 자리 남김)
+inline void Syscall_lsAppend(int buf_addr, int buf_size, int* written_len, const char* name) {
+  // 힙에 쓰기 (한 글자씩 int형으로 저장 - 현재 힙 구조상)
+  for (int k = 0; name[k] != 0; k++) {
+    if (*written_len < buf_size - 1) { // NULL 공간 남겨둠
+       if (buf_addr + *written_len < GLOBAL_HEAP_SIZE) {
+         global_heap[buf_addr + *written_len] = (int)name[k];
+         (*written_len)++;
+       }
+    }
+  }
+
+  // 개행 문자 추가
+  if (*written_len < buf_size - 1) {
+   if (buf_addr + *written_len < GLOBAL_HEAP_SIZE) {
+     global_heap[buf_addr + *written_len] = '\n';
+     (*written_len)++;
+   }
+  }
+}
 
 // [SysCall 1] ls - 특정 디렉터리 내용을 힙 버퍼에 저장
 // Stack Args: [TargetDirPathSelector, BufferSize, BufferAddr]
@@ -30,86 +55,65 @@ inline void Syscall_ls(Task* t) {
   }
 
   // [주소 변환] 커널도 태스크의 가상 주소를 물리 주소로 바꿔야 함
-  int phys_addr = Kernel_getPhysAddr(t, buf_addr);
-  buf_addr = phys_addr; // (변수 재활용)
+  // 버퍼 전체가 힙 안이어야 함 (아니면 아무것도 쓰지 않음)
+  int* buf = VM_heapRange(t, buf_addr, buf_size);
+  if (buf == NULL || buf_size <= 0) return;
+  buf_addr = buf - global_heap; // (변수 재활용)
 
-  // 1. 현재 실행 중인 파일 위치 저장 (파일 태스크일 경우만)
-  uint32_t current_pos = 0;
-  bool is_file_task = t->file.isOpen();
-  
-  if (is_file_task) {
-      current_pos = t->file.curPosition();
-      t->file.close();
+  // 버퍼 초기화
+  for(int i=0; i<buf_size; i++) {
+      if (buf_addr + i < GLOBAL_HEAP_SIZE) global_heap[buf_addr + i] = 0;
   }
-
-  // 2. 디렉터리 열기 (resolve_path로 변환된 절대 경로 사용)
-  File32 dir = sd.open(target_path);
   int written_len = 0;
 
-  if (dir) {
-    // 버퍼 초기화
-    for(int i=0; i<buf_size; i++) {
-        if (buf_addr + i < GLOBAL_HEAP_SIZE) global_heap[buf_addr + i] = 0;
+  if (Tmpfs_isPath(target_path)) {
+    // RAM 디스크: 이름 표를 tmpfs 디렉터리 커서로 나열
+    int8_t h = Tmpfs_opendir(t->id, target_path);
+    if (h == -1) {
+      if (buf_addr < GLOBAL_HEAP_SIZE) global_heap[buf_addr] = -1;
+      return;
+    }
+    char name[TMPFS_NAME_MAX];
+    uint16_t size;
+    while (Tmpfs_readdir(h, name, sizeof(name), &size) == 1) {
+      Syscall_lsAppend(buf_addr, buf_size, &written_len, name);
+    }
+    Tmpfs_close(h);
+  } else {
+    // 1. 디렉터리는 커널 핸들 풀에서 빌린 핸들로 연다
+    //    (실행 중인 코드 파일은 닫지 않으므로 위치 저장/재오픈/seek 이 필요 없음)
+    int8_t h = KFile_alloc(t->id);
+    File32* dir = KFile_get(h, t->id);
+    if (dir == NULL || !Dentry_open(target_path, dir)) {
+      KFile_free(h);
+      if (buf_addr < GLOBAL_HEAP_SIZE) global_heap[buf_addr] = -1;
+      return;
     }
 
     // 파일 목록 읽기
     for (;;) {
-      File32 entry = dir.openNextFile();
+      File32 entry = dir->openNextFile();
       if (!entry) break;
 
       char name[32];
       memset(name, 0, sizeof(name));
       entry.getName(name, sizeof(name));
-      
+
       // 디렉토리면 '/' 추가
       if (entry.isDirectory()) {
         int len = strlen(name);
         if (len < 30) { name[len] = '/'; name[len+1] = 0; }
       }
-      
-      // 힙에 쓰기 (한 글자씩 int형으로 저장 - 현재 힙 구조상)
-      for (int k = 0; name[k] != 0; k++) {
-        if (written_len < buf_size - 1) { // NULL 공간 남겨둠
-           if (buf_addr + written_len < GLOBAL_HEAP_SIZE) {
-             global_heap[buf_addr + written_len] = (int)name[k];
-             written_len++;
-           }
-        }
-      }
-      
-      // 개행 문자 추가
-      if (written_len < buf_size - 1) {
-       if (buf_addr + written_len < GLOBAL_HEAP_SIZE) {
-         global_heap[buf_addr + written_len] = '\n';
-         written_len++;
-       }
-      }
+      Syscall_lsAppend(buf_addr, buf_size, &written_len, name);
 
       entry.close();
     }
-    dir.close();
-    
-    // NULL Terminate
-    if (buf_addr + written_len < GLOBAL_HEAP_SIZE) {
-        global_heap[buf_addr + written_len] = 0;
-    }
-
-  } else {
-    // [수정] 모든 태스크에 대해 에러 플래그(-1) 반환 (죽이지 않음)
-    if (buf_addr < GLOBAL_HEAP_SIZE) global_heap[buf_addr] = -1;
-    return; 
+    KFile_free(h);
   }
 
-  // 3. 파일 다시 열고 위치 복구 (Resume execution)
-  if (is_file_task) {
-      t->file = sd.open(t->filename, FILE_READ);
-      
-      if (t->file) { // 열기 성공?
-        t->file.seek(current_pos);
-      } else { // 열기 실패?
-        t->setFree();
-      }
+  // NULL Terminate
+  if (buf_addr + written_len < GLOBAL_HEAP_SIZE) {
+      global_heap[buf_addr + written_len] = 0;
   }
 }
 #endif
-
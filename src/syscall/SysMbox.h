@@ -0,0 +1,58 @@
+#ifndef SYS_MBOX_H
+#define SYS_MBOX_H
+
+#include "Kernel.h"
+#include "Mailbox.h"
+#include "VirtualMachine.h"
+
+// [SysCall 40] send - 힙의 BufAddr 부터 Len 개 (MBOX_WORDS 이하) int 를 DstTask 의 메일박스로 복사
+// Stack Args: [DstTask, BufAddr, Len] -> Push: [0=성공, -1=실패]
+// DstTask = -1 이면 부모 (자신을 exec 한 태스크), 메시지 칸이 모두 찼으면 빌 때까지 막힘
+inline void Syscall_send(Task* t) {
+  int len = t->stack[t->sp--];
+  int buf_addr = t->stack[t->sp--];
+  int dst = t->stack[t->sp--];
+
+  int* buf = VM_heapRange(t, buf_addr, len);
+  if (buf == NULL) {
+    t->stack[++t->sp] = -1;
+    return;
+  }
+
+  int r = Mailbox_send(t, dst, buf, len);
+  if (r != MBOX_BLOCK) t->stack[++t->sp] = r;
+}
+
+// [SysCall 41] recv - 자기 메일박스에서 가장 먼저 온 메시지를 BufAddr 로 꺼냄 (없으면 막힘)
+// Stack Args: [BufAddr, MaxLen] -> Push: [Len, Sender] (Sender 가 맨 위, 실패 시 [-1, -1])
+// Len = -1 이면 블록 메시지: BufAddr[0] = 블록 주소 (이제 내 것, FREE 가능), BufAddr[1] = 크기
+inline void Syscall_recv(Task* t) {
+  int max_len = t->stack[t->sp--];
+  int buf_addr = t->stack[t->sp--];
+
+  int* buf = VM_heapRange(t, buf_addr, max_len);
+  if (buf == NULL) {
+    t->stack[++t->sp] = -1;
+    t->stack[++t->sp] = -1;
+    return;
+  }
+
+  int sender;
+  int len = Mailbox_recv(t, buf, max_len, &sender);
+  if (len == MBOX_BLOCK) return;
+  t->stack[++t->sp] = len;
+  t->stack[++t->sp] = sender;
+}
+
+// [SysCall 42] sendblk - MALLOC 으로 얻은 블록의 소유권을 DstTask 에게 넘김 (바이트 복사 없음)
+// Stack Args: [DstTask, Ptr] -> Push: [0=성공, -1=실패 (내 블록 아님/상대 할당 표 가득)]
+// 성공하면 보낸 쪽은 더 이상 그 블록을 FREE 할 수 없음
+inline void Syscall_sendblk(Task* t) {
+  int ptr = t->stack[t->sp--];
+  int dst = t->stack[t->sp--];
+
+  int r = Mailbox_sendBlock(t, dst, ptr);
+  if (r != MBOX_BLOCK) t->stack[++t->sp] = r;
+}
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef SYS_MMAP_H
+#define SYS_MMAP_H
+
+#include "Kernel.h"
+#include "Mmap.h"
+#include "SysHeap.h"
+
+// [SysCall 47] mmap - 파일 구간을 매핑 창에 묶음 (태스크당 하나)
+// Stack Args: [PathAddr, Page, Len, Flags] -> Push: [창 시작 주소 (MMAP_VBASE), -1=실패]
+// Page: 파일 시작 위치 (MMAP_FRAME_SIZE 바이트 단위), Len: 칸 수 (0 = 파일 끝까지, 최대 MMAP_WINDOW)
+// Flags: 1 = 쓰기 가능 (파일이 없으면 만들고, 끝 너머에 쓰면 늘어남), 0 = 읽기 전용
+// PathAddr = 0 이면 묶인 파일은 그대로 두고 창만 옮김 (큰 파일을 차례로 훑을 때)
+// 이미 묶여 있으면 더러운 페이지를 쓴 뒤 다시 묶고, 실패하면 매핑이 풀림
+// 창의 한 칸은 파일의 한 바이트이며 LOAD/STORE 로만 접근 (배열 명령/시스템 콜 버퍼로는 못 씀)
+inline void Syscall_mmap(Task* t) {
+  int flags = t->stack[t->sp--];
+  int len = t->stack[t->sp--];
+  int page = t->stack[t->sp--];
+  int path_addr = t->stack[t->sp--];
+
+  if (page < 0 || len < 0) {
+    t->stack[++t->sp] = -1;
+    return;
+  }
+
+  char target_path[64];
+  if (path_addr != 0) {
+    char path_str[32];
+    Syscall_heapString(t, path_addr, path_str, sizeof(path_str));
+    resolve_path(t, path_str, target_path);
+  }
+  t->stack[++t->sp] = Mmap_map(t, (path_addr != 0) ? target_path : NULL,
+                               (uint16_t)page, (uint16_t)len, (uint8_t)flags);
+}
+
+// [SysCall 48] munmap - 더러운 페이지를 파일에 쓰고 매핑을 풂 (태스크 종료 시 자동)
+// Stack Args: [VAddr] -> Push: [0=성공, -1=실패]
+inline void Syscall_munmap(Task* t) {
+  int vaddr = t->stack[t->sp--];
+  t->stack[++t->sp] = Mmap_unmap(t, vaddr);
+}
+
+#endif
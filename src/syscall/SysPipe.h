@@ -0,0 +1,33 @@
+#ifndef SYS_PIPE_H
+#define SYS_PIPE_H
+
+#include "Kernel.h"
+#include "KFile.h"
+#include "Pipe.h"
+#include "VirtualMachine.h"
+
+// [SysCall 30] pipe - 파이프를 만들어 읽는 끝/쓰는 끝 fd 를 BufAddr[0], BufAddr[1] 에 기록
+// Stack Args: [BufAddr] -> Push: [0=성공, -1=실패 (파이프/fd 자리 없음)]
+// 자식에게 넘길 때는 exec 인자에 "<&fd" (stdin) / ">&fd" (stdout) 를 붙임
+inline void Syscall_pipe(Task* t) {
+  int buf_addr = t->stack[t->sp--];
+  int* out = VM_heapRange(t, buf_addr, 2);
+
+  int fds[2] = {-1, -1};
+  for (int i = FD_STDERR + 1, n = 0; i < TASK_FDS && n < 2; i++) {
+    if (t->fds[i] == KFILE_NONE) fds[n++] = i;
+  }
+
+  int8_t r, w;
+  if (out == NULL || fds[1] == -1 || Pipe_create(&r, &w) == -1) {
+    t->stack[++t->sp] = -1;
+    return;
+  }
+  t->fds[fds[0]] = r;
+  t->fds[fds[1]] = w;
+  out[0] = fds[0];
+  out[1] = fds[1];
+  t->stack[++t->sp] = 0;
+}
+
+#endif
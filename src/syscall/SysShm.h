@@ -0,0 +1,43 @@
+#ifndef SYS_SHM_H
+#define SYS_SHM_H
+
+#include "Kernel.h"
+#include "Shm.h"
+#include "SysHeap.h"
+
+#define SHM_NAME_MAX 12  // 세그먼트 이름 최대 길이
+
+// [SysCall 45] shmget - 이름 있는 공유 세그먼트를 만들거나 붙임
+// Stack Args: [NameAddr, Size, PathAddr] -> Push: [가상 시작 주소, -1=실패]
+// 처음 만드는 태스크가 Size 를 정하고, PathAddr 가 0 이 아니면 그 파일로 한 번만 채움 (한 칸에 한 바이트)
+// 이미 있으면 Size 는 기존 크기 이하여야 하고 PathAddr 는 무시됨
+// 반환 주소는 모든 태스크에서 같으며 LOAD/STORE/배열 명령/시스템 콜에 그대로 쓸 수 있음
+inline void Syscall_shmget(Task* t) {
+  int path_addr = t->stack[t->sp--];
+  int size = t->stack[t->sp--];
+  int name_addr = t->stack[t->sp--];
+
+  char name[SHM_NAME_MAX + 1];
+  Syscall_heapString(t, name_addr, name, sizeof(name));
+  if (name[0] == '\0') {
+    t->stack[++t->sp] = -1;
+    return;
+  }
+
+  char target_path[64];
+  if (path_addr != 0) {
+    char path_str[32];
+    Syscall_heapString(t, path_addr, path_str, sizeof(path_str));
+    resolve_path(t, path_str, target_path);
+  }
+  t->stack[++t->sp] = Shm_attach(t, name, size, (path_addr != 0) ? target_path : NULL);
+}
+
+// [SysCall 46] shmdt - 공유 세그먼트 떼기 (마지막으로 떼면 반납, 태스크 종료 시 자동)
+// Stack Args: [VAddr] -> Push: [0=성공, -1=실패]
+inline void Syscall_shmdt(Task* t) {
+  int vaddr = t->stack[t->sp--];
+  t->stack[++t->sp] = Shm_detach(t, vaddr);
+}
+
+#endif
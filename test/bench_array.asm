@@ -0,0 +1,64 @@
+# @heap 160
+# bench_array.asm - 배열 연산(ASUM ~ ACRC) 벤치마크
+#
+# Heap[0]        : 반복 카운터
+# Heap[1]        : 시작 시각 (ms, 하위 16비트)
+# Heap[16..79]   : 배열 A (64개)
+# Heap[80..143]  : 배열 B (64개)
+# Heap[144..151] : 히스토그램 (8구간)
+#
+# 각 커널을 500번씩 호출하고 결과와 "경과 ms" 를 출력합니다.
+# 반복 횟수(PUSH 500)를 바꿔 시간을 조절하세요.
+
+.string MS_MSG "ms: "
+
+INIT:
+    PUSH 0; PUSH 0; STORE
+
+    # 힙은 이전 태스크가 쓰던 칸일 수 있으므로 먼저 0 으로 지운 뒤
+    # A[i] = 3, B[i] = 2 로 채움 (스칼라 곱 0 -> 스칼라 덧셈)
+    PUSH 16; PUSH 136; PUSH 0; AMULS
+    PUSH 16; PUSH 64; PUSH 3; AADDS
+    PUSH 80; PUSH 64; PUSH 2; AADDS
+
+    # 값에 변화를 줌: A[10] = 50, A[40] = -7
+    PUSH 50; PUSH 26; STORE
+    PUSH -7; PUSH 56; STORE
+
+    NATIVE 4; POP; PUSH 1; STORE   # Heap[1] = millis() 하위 16비트
+
+LOOP:
+    PUSH 0; LOAD; PUSH 500; EQ
+    JIF FINISH
+
+    PUSH 16; PUSH 64; ASUM; POP
+    PUSH 16; PUSH 64; AMIN; POP; POP
+    PUSH 16; PUSH 64; AMAX; POP; POP
+    PUSH 80; PUSH 64; PUSH 0; AADDS
+    PUSH 80; PUSH 64; PUSH 1; AMULS
+    PUSH 80; PUSH 16; PUSH 64; AADD
+    PUSH 80; PUSH 64; PUSH -1; AMULS  # B = -(A + B)
+    PUSH 80; PUSH 16; PUSH 64; AADD   # B = -B
+    PUSH 80; PUSH 64; PUSH -1; AMULS  # B = B (원래 값으로 복구)
+    PUSH 16; PUSH 80; PUSH 64; ADOT; POP
+    PUSH 16; PUSH 64; PUSH 144; PUSH 8; PUSH 0; PUSH 8; AHIST
+    PUSH 16; PUSH 64; ACRC; POP; POP
+
+    PUSH 0; LOAD; PUSH 1; ADD; PUSH 0; STORE
+    JMP LOOP
+
+FINISH:
+    # 경과 시간 (ms)
+    PRTR MS_MSG
+    NATIVE 4; POP; PUSH 1; LOAD; SUB; PRINT
+
+    # 결과 출력: sum, min/argmin, max/argmax, dot, crc(hi, lo)
+    PUSH 16; PUSH 64; ASUM; PRINT
+    PUSH 16; PUSH 64; AMIN; PRINT; PRINT
+    PUSH 16; PUSH 64; AMAX; PRINT; PRINT
+    PUSH 16; PUSH 80; PUSH 64; ADOT; PRINT
+    PUSH 16; PUSH 64; ACRC; PRINT; PRINT
+
+    PUSH 'D'; PRTC; PUSH 'O'; PRTC; PUSH 'N'; PRTC; PUSH 'E'; PRTC
+    PUSH 10; PRTC
+    EXIT
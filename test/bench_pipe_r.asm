@@ -0,0 +1,36 @@
+# @heap 48
+# bench_pipe_r.asm - 파이프 처리량 벤치마크 (읽는 쪽)
+# 실행: exec bench_pipe_w | bench_pipe_r
+#
+# Heap[0]      : 시작 시각 (ms, 하위 16비트)
+# Heap[2]      : 받은 바이트 수
+# Heap[3]      : 이번 read 결과
+# Heap[8..39]  : 읽기 버퍼
+#
+# stdin(fd 0) 을 EOF 까지 32 바이트씩 읽고 "바이트 수", "경과 ms" 를 출력합니다.
+# 처리량 (bytes/s) = 바이트 수 * 1000 / 경과 ms
+
+.string BYTES_MSG "bytes: "
+.string MS_MSG "ms: "
+
+START:
+    NATIVE 4; POP; PUSH 0; STORE   # Heap[0] = millis() 하위 16비트
+    PUSH 0; PUSH 2; STORE
+
+LOOP:
+    PUSH 8; PUSH 32; PUSH 0; PUSH 21; SYS        # read(fd 0, Heap[8], 32) -> [n]
+    PUSH 3; STORE
+    PUSH 3; LOAD; PUSH 0; EQ
+    JIF FINISH                                   # EOF (쓰는 쪽 종료)
+    PUSH 3; LOAD; PUSH -1; EQ
+    JIF FINISH                                   # 파이프가 아님
+
+    PUSH 2; LOAD; PUSH 3; LOAD; ADD; PUSH 2; STORE
+    JMP LOOP
+
+FINISH:
+    PRTR BYTES_MSG
+    PUSH 2; LOAD; PRINT
+    PRTR MS_MSG
+    NATIVE 4; POP; PUSH 0; LOAD; SUB; PRINT
+    EXIT
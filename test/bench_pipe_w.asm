@@ -0,0 +1,25 @@
+# @heap 40
+# bench_pipe_w.asm - 파이프 처리량 벤치마크 (쓰는 쪽)
+# 실행: exec bench_pipe_w | bench_pipe_r   (읽는 쪽이 바이트 수와 경과 ms 를 출력)
+#
+# Heap[0]      : 반복 카운터
+# Heap[8..39]  : 32 바이트 블록 ('x')
+#
+# 블록을 256번 (8 KB) stdout(fd 1) 으로 씁니다. 링이 차면 SYS write 가 막혀 읽는 쪽에 양보합니다.
+
+INIT:
+    PUSH 0; PUSH 0; STORE
+    PUSH 8; PUSH 32; PUSH 0; AMULS     # 힙은 0 으로 초기화되지 않으므로 먼저 비움
+    PUSH 8; PUSH 32; PUSH 'x'; AADDS
+
+LOOP:
+    PUSH 0; LOAD; PUSH 256; EQ
+    JIF FINISH
+
+    PUSH 8; PUSH 32; PUSH 1; PUSH 22; SYS; POP   # write(fd 1, Heap[8], 32)
+
+    PUSH 0; LOAD; PUSH 1; ADD; PUSH 0; STORE
+    JMP LOOP
+
+FINISH:
+    EXIT
@@ -0,0 +1,29 @@
+# @heap 24
+# ckpt_counter.asm - 체크포인트 예제 (SD 에 /ckpt 디렉터리 필요)
+# 1초마다 카운터를 올리고 /ckpt/cnt.ckp 에 자기 상태를 저장합니다.
+# 전원이 나간 뒤 resume (SYS 51) 하거나 CKPT_AUTORESUME=1 로 부팅하면
+# 마지막 저장 지점의 SYS 뒤에서 결과 1 을 받고 카운터를 이어서 셉니다.
+#
+# Heap[0]      : 카운터
+# Heap[8..21]  : 체크포인트 경로
+
+.string PATH "/ckpt/cnt.ckp"
+.string RESUMED_MSG "resumed\n"
+
+START:
+    PUSH 8; PUSH 14; RCOPY PATH
+    PUSH 0; PUSH 0; STORE                         # (실제 프로그램이라면 긴 초기화 단계)
+
+LOOP:
+    PUSH 0; LOAD; PUSH 1; ADD; PUSH 0; STORE
+    PUSH 0; LOAD; PRINT
+    PUSH -1; PUSH 8; PUSH 0; PUSH 50; SYS         # checkpoint(자신, 경로, 계속 실행)
+    PUSH 1; EQ
+    JIF RESUMED
+    PUSH 1000; SLEEP
+    JMP LOOP
+
+RESUMED:
+    PRTR RESUMED_MSG
+    PUSH 1000; SLEEP
+    JMP LOOP
@@ -0,0 +1,89 @@
+# @heap 48
+# 파일 입출력 예제 (open/read/write/close): log.txt 에 한 줄 이어 쓰고 전체를 읽어 출력
+# Heap[0] = fd, Heap[1~8] = 경로, Heap[10~21] = 쓸 줄, Heap[30] = 읽은 길이, Heap[32~47] = 읽기 버퍼
+
+.string PATH "log.txt"
+.string LINE "hello file\n"
+.string FAIL_MSG "open failed\n"
+
+START:
+    PUSH 1
+    PUSH 8
+    RCOPY PATH      # Heap[1..8] = "log.txt"
+    PUSH 10
+    PUSH 12
+    RCOPY LINE      # Heap[10..21] = "hello file\n"
+
+    # 1. 이어 쓰기
+    PUSH 1          # PathAddr
+    PUSH 2          # OPEN_APPEND
+    PUSH 20         # open
+    SYS
+    PUSH 0
+    STORE           # Heap[0] = fd
+    PUSH 0
+    LOAD
+    PUSH -1
+    EQ
+    JIF FAIL
+
+    PUSH 10         # BufAddr
+    PUSH 11         # Len
+    PUSH 0
+    LOAD            # fd
+    PUSH 22         # write
+    SYS
+    POP
+    PUSH 0
+    LOAD
+    PUSH 24         # close
+    SYS
+    POP
+
+    # 2. 처음부터 읽어서 표준 출력(fd 1)으로 블록 단위 복사
+    PUSH 1
+    PUSH 0          # OPEN_READ
+    PUSH 20
+    SYS
+    PUSH 0
+    STORE
+    PUSH 0
+    LOAD
+    PUSH -1
+    EQ
+    JIF FAIL
+
+READ:
+    PUSH 32         # BufAddr
+    PUSH 16         # Len
+    PUSH 0
+    LOAD            # fd
+    PUSH 21         # read
+    SYS
+    PUSH 30
+    STORE           # Heap[30] = n
+    PUSH 30
+    LOAD
+    PUSH 0
+    EQ
+    JIF CLOSE
+    PUSH 32
+    PUSH 30
+    LOAD
+    PUSH 1          # FD_STDOUT
+    PUSH 22         # write
+    SYS
+    POP
+    JMP READ
+
+CLOSE:
+    PUSH 0
+    LOAD
+    PUSH 24
+    SYS
+    POP
+    EXIT
+
+FAIL:
+    PRTR FAIL_MSG
+    EXIT
@@ -0,0 +1,26 @@
+# @heap 16
+# rodata 예제: 문자열 리터럴을 코드 파일에서 바로 출력 (PRTR)
+# test.asm 의 "PUSH 'D'; PRTC; ..." (글자당 4바이트, 명령 2개, 패킷 1개) 대비
+# 문자열 전체가 명령 1개, 패킷 1개로 나갑니다.
+
+.string HELLO "Hello from rodata!\n"
+.string DONE  "DONE\n"
+.data   DIGITS '0', '1', '2', '3'
+
+START:
+    PRTR HELLO
+
+    # rodata -> 힙 복사 후 힙 문자열 출력 (Heap[0..3] = "0123", Heap[4] = 0)
+    PUSH 0
+    PUSH 4
+    RCOPY DIGITS
+    PUSH 0
+    PUSH 4
+    STORE
+    PUSH 0
+    PRTS
+    PUSH 10
+    PRTC
+
+    PRTR DONE
+    EXIT
@@ -0,0 +1,53 @@
+# @heap 40
+# 디렉터리 커서 예제 (opendir/readdir/closedir): 항목을 하나씩 꺼내 "이름 크기" 로 출력
+# ls.asm 과 달리 목록 전체를 담을 버퍼가 필요 없습니다 (Heap[0] = 핸들, Heap[1~35] = 항목)
+# 항목 레이아웃: [1] 속성, [2] 크기 하위, [3] 크기 상위, [4~] 이름
+
+.string FAIL_MSG "opendir failed\n"
+
+START:
+    PUSH 0          # PathAddr (0 = CWD)
+    PUSH 10         # opendir
+    SYS             # -> [handle]
+    PUSH 0
+    STORE           # Heap[0] = handle
+    PUSH 0
+    LOAD
+    PUSH -1
+    EQ
+    JIF FAIL
+
+NEXT:
+    PUSH 1          # EntAddr
+    PUSH 0
+    LOAD            # DirHandle
+    PUSH 11         # readdir
+    SYS             # -> [1=항목, 0=끝, -1=오류]
+    PUSH 1
+    EQ
+    JIF SHOW
+    JMP CLOSE
+
+SHOW:
+    PUSH 4
+    PRTS            # 이름
+    PUSH 32         # ' '
+    PRTC
+    PUSH 2
+    LOAD
+    PRINT           # 크기 (하위 16비트)
+    PUSH 10
+    PRTC
+    JMP NEXT
+
+CLOSE:
+    PUSH 0
+    LOAD
+    PUSH 12         # closedir
+    SYS
+    POP
+    EXIT
+
+FAIL:
+    PRTR FAIL_MSG
+    EXIT
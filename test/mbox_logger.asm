@@ -0,0 +1,38 @@
+# @heap 24
+# mbox_logger.asm - 메일박스 예제 (받는 쪽)
+# 실행: exec mbox_logger   (mbox_sensor 를 비동기로 띄우고 메시지를 받아 출력)
+#
+# Heap[1..12]  : 자식 이름
+# Heap[14]     : 받은 길이 (-1 = 블록 메시지)
+# Heap[15]     : 보낸 태스크 ID
+# Heap[16..19] : 받기 버퍼
+#
+# 메시지가 없으면 recv 가 막혀 폴링 없이 기다립니다.
+
+.string SENSOR "mbox_sensor"
+.string GOT_MSG "got "
+.string BLK_MSG "blk sum "
+
+START:
+    PUSH 1; PUSH 12; RCOPY SENSOR
+    PUSH 0; PUSH 1; PUSH 0; PUSH 2; SYS           # exec(mbox_sensor, 비동기)
+
+LOOP:
+    PUSH 16; PUSH 4; PUSH 41; SYS                 # recv(Heap[16..19], 4) -> [len, sender]
+    PUSH 15; STORE
+    PUSH 14; STORE
+    PUSH 15; LOAD; PUSH -1; EQ
+    JIF FINISH                                    # 받기 실패
+    PUSH 14; LOAD; PUSH -1; EQ
+    JIF BLOCK
+
+    PRTR GOT_MSG
+    PUSH 17; LOAD; PRINT                          # 측정값
+    JMP LOOP
+
+BLOCK:
+    PRTR BLK_MSG
+    PUSH 16; LOAD; PUSH 17; LOAD; ASUM; PRINT     # 넘겨받은 블록 합 (96)
+
+FINISH:
+    EXIT
@@ -0,0 +1,30 @@
+# @heap 8
+# mbox_sensor.asm - 메일박스 예제 (보내는 쪽, mbox_logger 가 exec 함)
+#
+# Heap[0] : 측정 번호
+# Heap[1] : 측정값 (여기서는 번호 + 100)
+# Heap[4] : 묶음 블록 주소 (MALLOC)
+#
+# 측정값 10개를 부모에게 복사 메시지 [번호, 값] 으로 보내고,
+# 마지막에 32칸 묶음을 MALLOC 블록째로 넘깁니다 (sendblk, 바이트 복사 없음).
+
+START:
+    PUSH 0; PUSH 0; STORE
+
+LOOP:
+    PUSH 0; LOAD; PUSH 10; EQ
+    JIF BULK
+
+    PUSH 0; LOAD; PUSH 100; ADD; PUSH 1; STORE     # Heap[1] = 번호 + 100
+    PUSH -1; PUSH 0; PUSH 2; PUSH 40; SYS; POP     # send(부모, Heap[0..1], 2)
+
+    PUSH 50; SLEEP
+    PUSH 0; LOAD; PUSH 1; ADD; PUSH 0; STORE
+    JMP LOOP
+
+BULK:
+    PUSH 32; MALLOC; PUSH 4; STORE
+    PUSH 4; LOAD; PUSH 32; PUSH 0; AMULS
+    PUSH 4; LOAD; PUSH 32; PUSH 3; AADDS          # 블록 = 3 x 32
+    PUSH -1; PUSH 4; LOAD; PUSH 42; SYS; POP       # sendblk(부모, 블록) -> 이제 부모 것
+    EXIT
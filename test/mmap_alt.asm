@@ -0,0 +1,53 @@
+# @heap 24
+# mmap_alt.asm - 페이지 캐시 번갈아 읽기 테스트
+# data.csv 앞 1024 bytes 를 한 창에 묶고, 멀리 떨어진 두 구간 (창[0..127] 과 창[768..895], 서로 다른 페이지)
+# 을 한 바이트씩 번갈아 읽어 두 구간의 줄 수와 경과 ms 를 출력합니다.
+# 매핑은 태스크당 하나이므로 두 번째 매핑은 다른 태스크가 만듭니다:
+#   exec mmap_alt 를 두 번 (비동기) 실행하면 매핑 둘 x 구간 둘이 스케줄러 순서대로 번갈아 프레임을 씁니다.
+# 프레임이 넉넉하면 (MMAP_FRAMES 4) 첫 접근 뒤로 모두 적중하고, 하나뿐이면 거의 매번 놓칩니다
+# (CMD_STATS 의 mmap pages hit rate 로 확인).
+#
+# Heap[0]     : 창 시작 주소 (mmap 결과)
+# Heap[1]     : 구간 안 인덱스 i
+# Heap[2]     : 줄 수
+# Heap[3]     : 시작 시각 (ms)
+# Heap[8..16] : 파일 경로
+
+.string PATH "data.csv"
+.string LINES_MSG "lines "
+.string MS_MSG " ms "
+.string FAIL_MSG "mmap failed\n"
+
+START:
+    PUSH 8; PUSH 9; RCOPY PATH
+    PUSH 8; PUSH 0; PUSH 1024; PUSH 0; PUSH 47; SYS   # mmap("data.csv", page 0, 1024, 읽기 전용)
+    PUSH 0; STORE
+    PUSH 0; LOAD; PUSH -1; EQ
+    JIF FAIL
+    PUSH 0; PUSH 1; STORE
+    PUSH 0; PUSH 2; STORE
+    NATIVE 4; POP; PUSH 3; STORE
+
+LOOP:
+    PUSH 1; LOAD; PUSH 128; EQ
+    JIF DONE
+    PUSH 0; LOAD; PUSH 1; LOAD; ADD; LOAD            # 앞 구간: 창[i]
+    PUSH 10; EQ
+    PUSH 2; LOAD; ADD; PUSH 2; STORE
+    PUSH 0; LOAD; PUSH 768; ADD; PUSH 1; LOAD; ADD; LOAD   # 뒤 구간: 창[768 + i]
+    PUSH 10; EQ
+    PUSH 2; LOAD; ADD; PUSH 2; STORE
+    PUSH 1; LOAD; PUSH 1; ADD; PUSH 1; STORE
+    JMP LOOP
+
+DONE:
+    PRTR LINES_MSG
+    PUSH 2; LOAD; PRINT
+    PRTR MS_MSG
+    NATIVE 4; POP; PUSH 3; LOAD; SUB; PRINT
+    PUSH 0; LOAD; PUSH 48; SYS; POP                  # munmap
+    EXIT
+
+FAIL:
+    PRTR FAIL_MSG
+    EXIT
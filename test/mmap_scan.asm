@@ -0,0 +1,57 @@
+# @heap 24
+# mmap_scan.asm - 파일 매핑 예제
+# data.csv 앞 2048 bytes 를 512 칸 창 (4페이지, 페이지 = MMAP_FRAME_SIZE 128 bytes) 으로 훑으며 줄 수를 셉니다.
+# 창의 한 칸이 파일의 한 바이트이므로 READ 버퍼 없이 LOAD 만으로 읽습니다.
+#
+# Heap[0]     : 창 시작 주소 (mmap 결과)
+# Heap[1]     : 창 안 인덱스
+# Heap[2]     : 줄 수
+# Heap[3]     : 창 시작 페이지 (4씩 증가)
+# Heap[8..16] : 파일 경로
+
+.string PATH "data.csv"
+.string LINES_MSG "lines "
+.string FAIL_MSG "mmap failed\n"
+
+START:
+    PUSH 8; PUSH 9; RCOPY PATH
+    PUSH 8; PUSH 0; PUSH 512; PUSH 0; PUSH 47; SYS    # mmap("data.csv", page 0, 512, 읽기 전용)
+    PUSH 0; STORE
+    PUSH 0; PUSH 2; STORE
+    PUSH 0; PUSH 3; STORE
+
+PAGE:
+    PUSH 0; LOAD; PUSH -1; EQ
+    JIF FAIL
+    PUSH 0; PUSH 1; STORE
+
+SCAN:
+    PUSH 1; LOAD; PUSH 512; EQ
+    JIF NEXT
+    PUSH 0; LOAD; PUSH 1; LOAD; ADD; LOAD         # 창[i] = 파일 바이트 (페이지 캐시)
+    PUSH 10; EQ
+    JIF NEWLINE
+BUMP:
+    PUSH 1; LOAD; PUSH 1; ADD; PUSH 1; STORE
+    JMP SCAN
+NEWLINE:
+    PUSH 2; LOAD; PUSH 1; ADD; PUSH 2; STORE
+    JMP BUMP
+
+NEXT:
+    PUSH 3; LOAD; PUSH 4; ADD; PUSH 3; STORE
+    PUSH 3; LOAD; PUSH 16; EQ
+    JIF DONE
+    PUSH 0; PUSH 3; LOAD; PUSH 512; PUSH 0; PUSH 47; SYS    # 경로 0: 같은 파일에서 창만 옮김
+    PUSH 0; STORE
+    JMP PAGE
+
+DONE:
+    PRTR LINES_MSG
+    PUSH 2; LOAD; PRINT
+    PUSH 0; LOAD; PUSH 48; SYS; POP                # munmap
+    EXIT
+
+FAIL:
+    PRTR FAIL_MSG
+    EXIT
@@ -0,0 +1,12 @@
+# PlatformIO pre 스크립트: 빌드 전에 /rom 이미지 (src/RomImage.cpp) 를 다시 만듭니다.
+# ROM_FILES 에 넣은 실행 파일은 플래시에서 바로 실행되어 SD 없이 뜹니다 (src/Rom.h).
+Import("env")
+import os
+import subprocess
+
+ROM_FILES = ["test/shell.asm", "test/ls.asm"]
+
+root = env.subst("$PROJECT_DIR")
+subprocess.check_call([env.subst("$PYTHONEXE"), os.path.join(root, "test", "vmtools.py"), "rom",
+                       os.path.join(root, "src", "RomImage.cpp")] +
+                      [os.path.join(root, f) for f in ROM_FILES])
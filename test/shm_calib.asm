@@ -0,0 +1,34 @@
+# @heap 24
+# shm_calib.asm - 공유 세그먼트 예제
+# 여러 태스크로 동시에 실행하면 처음 하나만 calib.dat 를 읽고 나머지는 붙기만 합니다.
+#
+# Heap[0]      : 세그먼트 가상 주소
+# Heap[1..6]   : 세그먼트 이름
+# Heap[8..17]  : 초기화 파일 경로
+#
+# "calib" 세그먼트 (32칸) 를 calib.dat 로 채워 붙이고 합계를 출력합니다.
+# 세그먼트는 마지막 태스크가 끝날 때 반납됩니다.
+
+.string NAME "calib"
+.string PATH "calib.dat"
+.string SUM_MSG "calib sum "
+.string FAIL_MSG "shmget failed\n"
+
+START:
+    PUSH 1; PUSH 6; RCOPY NAME
+    PUSH 8; PUSH 10; RCOPY PATH
+
+    PUSH 1; PUSH 32; PUSH 8; PUSH 45; SYS        # shmget("calib", 32, "calib.dat")
+    PUSH 0; STORE
+    PUSH 0; LOAD; PUSH -1; EQ
+    JIF FAIL
+
+    PRTR SUM_MSG
+    PUSH 0; LOAD; PUSH 32; ASUM; PRINT
+
+    PUSH 1000; SLEEP                              # 다른 태스크가 붙을 시간
+    EXIT
+
+FAIL:
+    PRTR FAIL_MSG
+    EXIT
@@ -0,0 +1,27 @@
+# @heap 16
+# test_v2.asm - test.asm 의 v2(레지스터 기반) 버전
+# 빌드: python vmtools.py asm2 test_v2.asm test_v2.bin
+#
+# R0: 카운터, R1: 목표 횟수, R2: 비교 결과, R3: 출력 문자
+
+INIT:
+    MOVI R0, 0
+    MOVI R1, 20000   # 목표 횟수 (이 숫자를 바꾸면 실행 시간 조절 가능)
+
+LOOP:
+    EQ   R2, R0, R1
+    JNZ  R2, FINISH
+    ADDI R0, R0, 1   # Counter++ (1 dispatch)
+    JMP  LOOP
+
+FINISH:
+    # 카운터를 힙에 남겨둠 (Heap[0] = Counter)
+    MOVI  R7, 0
+    STORE R0, R7, 0
+
+    MOVI R3, 'D'; PRTC R3
+    MOVI R3, 'O'; PRTC R3
+    MOVI R3, 'N'; PRTC R3
+    MOVI R3, 'E'; PRTC R3
+    MOVI R3, 10;  PRTC R3
+    EXIT
@@ -0,0 +1,35 @@
+# @heap 48
+# RAM 디스크 예제: /tmp/scr 에 쓰고 다시 읽어 출력한 뒤 삭제 (SD 카드를 건드리지 않음)
+# Heap[0] = fd, Heap[1~8] = 경로, Heap[10~21] = 쓸 줄, Heap[30] = 읽은 길이, Heap[32~47] = 읽기 버퍼
+
+.string PATH "/tmp/scr"
+.string LINE "scratch ok\n"
+.string FAIL_MSG "open failed\n"
+
+START:
+    PUSH 1; PUSH 9; RCOPY PATH      # Heap[1..9] = "/tmp/scr"
+    PUSH 10; PUSH 12; RCOPY LINE    # Heap[10..21] = "scratch ok\n"
+
+    # 1. 쓰기 (없으면 생성, 있으면 비움)
+    PUSH 1; PUSH 1; PUSH 20; SYS    # open(path, OPEN_WRITE)
+    PUSH 0; STORE
+    PUSH 0; LOAD; PUSH -1; EQ
+    JIF FAIL
+    PUSH 10; PUSH 11; PUSH 0; LOAD; PUSH 22; SYS; POP   # write(fd, Heap[10], 11)
+    PUSH 0; LOAD; PUSH 24; SYS; POP                     # close(fd)
+
+    # 2. 다시 읽어 출력
+    PUSH 1; PUSH 0; PUSH 20; SYS    # open(path, OPEN_READ)
+    PUSH 0; STORE
+    PUSH 32; PUSH 15; PUSH 0; LOAD; PUSH 21; SYS        # read(fd, Heap[32], 15)
+    PUSH 30; STORE
+    PUSH 32; PUSH 30; LOAD; PUSH 1; PUSH 22; SYS; POP   # write(stdout, Heap[32], n)
+    PUSH 0; LOAD; PUSH 24; SYS; POP
+
+    # 3. 삭제
+    PUSH 1; PUSH 25; SYS; POP       # unlink(path)
+    EXIT
+
+FAIL:
+    PRTR FAIL_MSG
+    EXIT
@@ -1,20 +1,263 @@
 #!/usr/bin/env python3
+import os
 import sys
+import zlib
 
 # ------------------------------------------------------------
 # 1. 명령어 정의 (OSConfig.h와 100% 일치해야 함)
 # ------------------------------------------------------------
 OPCODES = {
     "EXIT":   0x00,
-    "PRINT":  0x01, "READ":   0x02, "PRTC":   0x03, "PRTE":   0x04, "PRTS":   0x05,
+    "PRINT":  0x01, "READ":   0x02, "PRTC":   0x03, "PRTE":   0x04, "PRTS":   0x05, "PRTR": 0x06,
     "PUSH":   0x10, "ADD":    0x11, "SUB":    0x12, "EQ":     0x13, "DUP":    0x14, "POP": 0x15,
     "JMP":    0x20, "JIF":    0x21,
-    "SYS":    0x30,
+    "SYS":    0x30, "NATIVE": 0x31,
     "PIN_MODE": 0x40, "D_WRITE":  0x41, "SLEEP":    0x42,
-    "MALLOC": 0x50, "LOAD":   0x51, "STORE":  0x52,
+    "MALLOC": 0x50, "LOAD":   0x51, "STORE":  0x52, "RCOPY":  0x53,
+    "ASUM":   0x60, "AMIN":   0x61, "AMAX":   0x62, "AADDS":  0x63, "AMULS":  0x64,
+    "AADD":   0x65, "ADOT":   0x66, "AHIST":  0x67, "ACRC":   0x68,
 }
 
-OPS_WITH_IMM = {"PUSH", "JMP", "JIF"}
+OPS_WITH_IMM = {"PUSH", "JMP", "JIF", "NATIVE", "PRTR", "RCOPY"}
+
+# 네이티브 함수 이름 -> id (src/Native.h NATIVE_* 와 일치해야 함)
+# 사용 예: PUSH 6; PUSH 7; NATIVE mul  (-> 42)
+NATIVES = {
+    "mul": 0, "div": 1, "mod": 2, "abs": 3, "millis": 4,
+}
+
+# ------------------------------------------------------------
+# 1-2. v2 (레지스터 기반) 명령어 정의 (OSConfig.h VMRegOpcode와 일치)
+#   형식: N=[op], R=[op][r], RR=[op][rd<<4|ra][rb], RI=[op][rd<<4|ra][imm16], I=[op][imm16]
+#   operands: 'd'=첫 번째 레지스터, 'a'=두 번째 레지스터, 'b'=세 번째 레지스터, 'i'=즉시값/라벨
+# ------------------------------------------------------------
+REG_COUNT = 8
+REG_OPCODES = {
+    "EXIT":   (0x00, "N",  ""),
+    "PRINT":  (0x01, "R",  "d"),   "READ":  (0x02, "R", "d"),
+    "PRTC":   (0x03, "R",  "d"),   "PRTE":  (0x04, "R", "d"),   "PRTS": (0x05, "R", "d"),
+    "PRTR":   (0x06, "I",  "i"),
+    "MOVI":   (0x10, "RI", "di"),  "MOV":   (0x11, "R", "da"),
+    "ADD":    (0x12, "RR", "dab"), "SUB":   (0x13, "RR", "dab"), "EQ":  (0x14, "RR", "dab"),
+    "ADDI":   (0x15, "RI", "dai"),
+    "PUSH":   (0x16, "R",  "d"),   "POP":   (0x17, "R", "d"),
+    "JMP":    (0x20, "I",  "i"),
+    "JNZ":    (0x21, "RI", "di"),  "JZ":    (0x22, "RI", "di"),
+    "SYS":    (0x30, "I",  "i"),   "NATIVE": (0x31, "I", "i"),
+    "SLEEP":  (0x42, "R",  "d"),
+    "MALLOC": (0x50, "R",  "da"),
+    "LOAD":   (0x51, "RI", "dai"), "STORE": (0x52, "RI", "dai"),
+    "RCOPY":  (0x53, "RI", "dai"),
+}
+REG_FORMAT_SIZE = {"N": 1, "R": 2, "RR": 3, "RI": 4, "I": 3}
+
+# ------------------------------------------------------------
+# 1-3. 실행 파일 헤더 (OSConfig.h EXEC_* 와 일치)
+#   [0xAD][ver|0x80][heap u16][hdr_size][stack][flags][0]
+#   [code_size u16][entry u16][rodata_len u16][0 u16][crc32 u32] + code + rodata
+# ------------------------------------------------------------
+EXEC_VER_EXT = 0x80
+EXEC_EXT_HEADER_SIZE = 20
+EXEC_FLAG_PRELOAD = 0x01
+EXEC_FLAG_VERIFIED = 0x02
+DEFAULT_STACK = 64   # VM_STACK_SIZE
+MAX_STACK = 255
+
+# 소스 지시어 (# @heap 256, # @stack 16, # @entry main, # @preload)
+def parse_directive(raw_line, opts):
+    parts = raw_line.split()
+    if len(parts) < 2 or not parts[1].startswith("@"): return False
+    key = parts[1][1:]
+    if key in ("heap", "stack") and len(parts) >= 3:
+        opts[key] = int(parts[2])
+        print(f"[Info] Custom {key.capitalize()} Size: {opts[key]}")
+    elif key == "entry" and len(parts) >= 3:
+        opts["entry"] = parts[2]
+    elif key == "preload":
+        opts["preload"] = True
+    else:
+        print(f"[Warn] Invalid directive: {raw_line}")
+    return True
+
+# rodata 지시어 (코드 뒤에 붙는 읽기 전용 데이터, 라벨 값 = rodata 오프셋)
+#   .string NAME "text\n"      -> UTF-8 바이트 + NULL
+#   .data   NAME 1, 2, 'A', 0x30 -> 바이트 나열
+# 사용 예: PRTR NAME / PUSH dst; PUSH len; RCOPY NAME
+ESCAPES = {"n": "\n", "t": "\t", "r": "\r", "0": "\0", "\\": "\\", '"': '"'}
+
+def unescape(text):
+    out, i = [], 0
+    while i < len(text):
+        if text[i] == "\\" and i + 1 < len(text):
+            out.append(ESCAPES.get(text[i + 1], text[i + 1]))
+            i += 2
+        else:
+            out.append(text[i])
+            i += 1
+    return "".join(out)
+
+def parse_rodata(raw_line, rodata, rodata_labels):
+    parts = raw_line.split(None, 2)
+    if len(parts) < 3:
+        raise ValueError(f"Invalid rodata directive: {raw_line}")
+    kind, name, rest = parts
+    if name in rodata_labels:
+        raise ValueError(f"Duplicate rodata label: {name}")
+    if kind == ".string":
+        q1, q2 = rest.find('"'), rest.rfind('"')
+        if q1 < 0 or q2 <= q1:
+            raise ValueError(f"Invalid string literal: {raw_line}")
+        data = unescape(rest[q1 + 1:q2]).encode("utf-8") + b"\0"
+    elif kind == ".data":
+        data = bytes(parse_number(v) & 0xFF for v in rest.split("#", 1)[0].split(",") if v.strip())
+    else:
+        raise ValueError(f"Unknown directive: {kind}")
+    rodata_labels[name] = len(rodata)
+    rodata += data
+
+def merge_labels(labels, rodata_labels):
+    both = set(labels) & set(rodata_labels)
+    if both:
+        raise ValueError(f"Label defined in both code and rodata: {', '.join(sorted(both))}")
+    natives = {l for l in list(labels) + list(rodata_labels) if l.lower() in NATIVES}
+    if natives:
+        raise ValueError(f"Label collides with native function name: {', '.join(sorted(natives))}")
+    merged = dict(labels)
+    merged.update(rodata_labels)
+    return merged
+
+def build_image(isa, opts, labels, code, bound, rodata=b""):
+    """확장 헤더 + 코드 + rodata. bound 는 정적 분석한 스택 상한 (None 이면 실패)"""
+    heap_size = opts.get("heap", 128)
+    flags = EXEC_FLAG_PRELOAD if opts.get("preload") else 0
+
+    if bound is None:
+        stack = opts.get("stack", DEFAULT_STACK)
+        print(f"[Info] Stack bound not provable, using {stack}")
+    else:
+        stack = max(opts.get("stack", bound), 1)
+        if stack < bound:
+            print(f"[Warn] @stack {stack} is below the computed bound {bound}")
+        else:
+            flags |= EXEC_FLAG_VERIFIED
+        print(f"[Info] Stack bound: {bound} (reserved {stack})")
+    if stack > MAX_STACK:
+        raise ValueError(f"Stack size {stack} exceeds {MAX_STACK}")
+
+    entry = 0
+    if "entry" in opts:
+        if opts["entry"] not in labels:
+            raise ValueError(f"Unknown entry label: {opts['entry']}")
+        entry = labels[opts["entry"]]
+
+    crc = zlib.crc32(bytes(code) + bytes(rodata)) & 0xFFFFFFFF  # == sp_crc32
+    header = bytearray([0xAD, isa | EXEC_VER_EXT, heap_size & 0xFF, (heap_size >> 8) & 0xFF,
+                        EXEC_EXT_HEADER_SIZE, stack, flags, 0])
+    for v in (len(code), entry, len(rodata), 0):
+        header += v.to_bytes(2, "little")
+    header += crc.to_bytes(4, "little")
+    return bytes(header) + bytes(code) + bytes(rodata)
+
+# ------------------------------------------------------------
+# 1-4. 스택 상한 정적 분석
+#   제어 흐름을 따라가며 각 명령 진입 시 깊이를 구하고 최댓값을 리턴합니다.
+#   같은 명령에 다른 깊이로 도달(루프마다 쌓임 등)하거나 SYS 번호를 알 수 없으면 None.
+# ------------------------------------------------------------
+# v1 명령별 (pop, push) - VirtualMachine.cpp 와 일치
+STACK_EFFECTS = {
+    "EXIT": (0, 0), "PRINT": (1, 0), "READ": (0, 1), "PRTC": (1, 0), "PRTE": (1, 0), "PRTS": (1, 0),
+    "PRTR": (0, 0), "RCOPY": (2, 0),
+    "PUSH": (0, 1), "ADD": (2, 1), "SUB": (2, 1), "EQ": (2, 1), "DUP": (1, 2), "POP": (1, 0),
+    "JMP": (0, 0), "JIF": (1, 0),
+    "PIN_MODE": (2, 0), "D_WRITE": (2, 0), "SLEEP": (1, 0),
+    "MALLOC": (1, 1), "LOAD": (1, 1), "STORE": (2, 0),
+    "ASUM": (2, 1), "AMIN": (2, 2), "AMAX": (2, 2), "AADDS": (3, 0), "AMULS": (3, 0),
+    "AADD": (3, 0), "ADOT": (3, 1), "AHIST": (6, 0), "ACRC": (2, 2),
+}
+# 시스템 콜 (꺼내는 인자 수, 결과로 넣는 수) - src/syscall/*.h
+SYSCALL_ARITY = {1: (3, 0), 2: (3, 0), 3: (2, 0), 4: (1, 0),
+                 10: (1, 1), 11: (2, 1), 12: (1, 1),
+                 20: (2, 1), 21: (3, 1), 22: (3, 1), 23: (3, 1), 24: (1, 1), 25: (1, 1),
+                 30: (1, 1),
+                 40: (3, 1), 41: (2, 2), 42: (2, 1),
+                 45: (3, 1), 46: (1, 1), 47: (4, 1), 48: (1, 1),
+                 50: (3, 1), 51: (1, 1)}
+# 네이티브 함수 (argc, retc) - src/Native.cpp native_table
+NATIVE_ARITY = {0: (2, 1), 1: (2, 1), 2: (2, 1), 3: (1, 1), 4: (0, 2)}
+
+def _native_effect(op, labels, tok):
+    nid = resolve_native(tok, labels)
+    return NATIVE_ARITY.get(nid)
+
+def stack_effect_v1(ops, i, labels):
+    """(pop, push, [다음 pc...]) 또는 None"""
+    op = ops[i]
+    mnem = op["mnem"]
+    nxt = op["pc"] + op["size"]
+    if mnem == "SYS":
+        prev = ops[i - 1] if i > 0 else None
+        if prev is None or prev["mnem"] != "PUSH": return None
+        eff = SYSCALL_ARITY.get(resolve_imm(prev["operand"], labels))
+        return None if eff is None else (1 + eff[0], eff[1], [nxt])
+    if mnem == "NATIVE":
+        eff = _native_effect(op, labels, op["operand"])
+        return None if eff is None else (eff[0], eff[1], [nxt])
+    pop, push = STACK_EFFECTS[mnem]
+    if mnem == "EXIT": return (pop, push, [])
+    if mnem == "JMP": return (pop, push, [resolve_imm(op["operand"], labels)])
+    if mnem == "JIF": return (pop, push, [nxt, resolve_imm(op["operand"], labels)])
+    return (pop, push, [nxt])
+
+def stack_effect_v2(ops, i, labels):
+    op = ops[i]
+    mnem = op["mnem"]
+    nxt = op["pc"] + op["size"]
+    if mnem == "PUSH": return (0, 1, [nxt])
+    if mnem == "POP": return (1, 0, [nxt])
+    if mnem == "SYS":
+        eff = SYSCALL_ARITY.get(resolve_imm(op["operands"][0], labels))
+        return None if eff is None else (eff[0], eff[1], [nxt])
+    if mnem == "NATIVE":
+        eff = _native_effect(op, labels, op["operands"][0])
+        return None if eff is None else (eff[0], eff[1], [nxt])
+    if mnem == "EXIT": return (0, 0, [])
+    if mnem == "JMP": return (0, 0, [resolve_imm(op["operands"][0], labels)])
+    if mnem in ("JNZ", "JZ"): return (0, 0, [nxt, resolve_imm(op["operands"][1], labels)])
+    return (0, 0, [nxt])
+
+def stack_bound(ops, labels, effect_fn, entry=0):
+    index = {op["pc"]: i for i, op in enumerate(ops)}
+    depth_at = {}
+    work = [(entry, 0)]
+    bound = 0
+    while work:
+        pc, depth = work.pop()
+        if pc not in index:
+            if pc >= (ops[-1]["pc"] + ops[-1]["size"] if ops else 0): continue  # 코드 끝 -> 종료
+            return None  # 명령 중간으로 점프
+        i = index[pc]
+        if i in depth_at:
+            if depth_at[i] != depth: return None
+            continue
+        depth_at[i] = depth
+        eff = effect_fn(ops, i, labels)
+        if eff is None: return None
+        pop, push, succs = eff
+        if depth < pop: return None  # 언더플로 (런타임 에러)
+        depth = depth - pop + push
+        bound = max(bound, depth)
+        for s in succs: work.append((s, depth))
+    return bound
+
+def resolve_imm(tok, labels):
+    """즉시값 해석: 라벨 -> 숫자 순서"""
+    if tok in labels: return labels[tok]
+    return parse_number(tok)
+
+def resolve_native(tok, labels):
+    """NATIVE 피연산자 해석: 네이티브 함수 이름 -> 즉시값 순서"""
+    if tok.lower() in NATIVES: return NATIVES[tok.lower()]
+    return resolve_imm(tok, labels)
 
 def parse_number(tok):
     tok = tok.strip()
@@ -22,27 +265,31 @@ def parse_number(tok):
     if tok.startswith("'") and len(tok) == 3: return ord(tok[1])
     return int(tok, 10)
 
-def assemble(lines):
+def assemble(lines, symbols=None):
     parsed_ops = []
     labels = {}
     pc = 0
-    heap_size = 128 # Default Heap Size (if not specified)
+    opts = {"heap": 128} # Default Heap Size (if not specified)
+    rodata = bytearray()
+    rodata_labels = {}
 
     # -------------------------------------------------
     # Pass 1: 파싱, 라벨 계산, 헤더 정보 추출
     # -------------------------------------------------
-    for raw_line in lines:
+    for line_no, raw_line in enumerate(lines, 1):
         raw_line = raw_line.strip()
         
-        # [Header Directive Check] # @heap 256
-        if raw_line.startswith("# @heap"):
+        # [Header Directive Check] # @heap 256, # @stack 16 ...
+        if raw_line.startswith("# @"):
             try:
-                parts = raw_line.split()
-                if len(parts) >= 3:
-                    heap_size = int(parts[2])
-                    print(f"[Info] Custom Heap Size: {heap_size}")
-            except:
-                print("[Warn] Invalid heap directive")
+                parse_directive(raw_line, opts)
+            except ValueError:
+                print(f"[Warn] Invalid directive: {raw_line}")
+            continue
+
+        # [Rodata Directive] .string / .data (문자열 안의 # ; : 보존을 위해 먼저 처리)
+        if raw_line.startswith("."):
+            parse_rodata(raw_line, rodata, rodata_labels)
             continue
 
         # 1. 주석 제거 (# 문자 뒤는 무시)
@@ -75,17 +322,19 @@ def assemble(lines):
             parsed_ops.append({
                 "mnem": mnem,
                 "operand": operand,
-                "size": size
+                "size": size,
+                "pc": pc, "line": line_no, "text": inst
             })
             pc += size
 
+    if symbols is not None:
+        symbols.update(labels=labels, ops=parsed_ops)
+
     # -------------------------------------------------
     # Pass 2: 바이트코드 생성
     # -------------------------------------------------
-    # [Header Generation]
-    # Magic(1) + Ver(1) + HeapSize(2, LE)
-    header = bytearray([0xAD, 0x01, heap_size & 0xFF, (heap_size >> 8) & 0xFF])
-    
+    code_labels = labels
+    labels = merge_labels(labels, rodata_labels)
     body = []
     for op in parsed_ops:
         mnem = op["mnem"]
@@ -99,36 +348,281 @@ def assemble(lines):
             if operand is None:
                 raise ValueError(f"Opcode {mnem} requires an operand")
             
-            val = 0
-            if operand in labels:
-                val = labels[operand]
-            else:
-                val = parse_number(operand)
+            val = resolve_native(operand, labels) if mnem == "NATIVE" else resolve_imm(operand, labels)
             
             # Little Endian (Low byte, High byte)
             body.append(val & 0xFF)
             body.append((val >> 8) & 0xFF)
 
-    return header + bytes(body)
+    # [Header Generation] 확장 헤더 (스택 상한은 정적 분석으로 계산)
+    entry = labels.get(opts["entry"], 0) if "entry" in opts else 0
+    bound = stack_bound(parsed_ops, labels, stack_effect_v1, entry)
+    return build_image(0x01, opts, code_labels, body, bound, rodata)
+
+def parse_reg(tok):
+    tok = tok.strip().upper()
+    if not tok.startswith("R") or not tok[1:].isdigit() or int(tok[1:]) >= REG_COUNT:
+        raise ValueError(f"Invalid register: {tok}")
+    return int(tok[1:])
+
+def assemble_reg(lines, symbols=None):
+    """v2 (레지스터 기반) 어셈블러. 문법: 'ADD R0, R1, R2', 'LOAD R0, R7, 16', 'JNZ R2, LOOP'"""
+    parsed_ops = []
+    labels = {}
+    pc = 0
+    opts = {"heap": 128}
+    rodata = bytearray()
+    rodata_labels = {}
+
+    # Pass 1: 파싱, 라벨 계산
+    for line_no, raw_line in enumerate(lines, 1):
+        raw_line = raw_line.strip()
+
+        if raw_line.startswith("# @"):
+            parse_directive(raw_line, opts)
+            continue
+        if raw_line.startswith("."):
+            parse_rodata(raw_line, rodata, rodata_labels)
+            continue
+
+        code_part = raw_line.split("#", 1)[0].strip()
+        if not code_part: continue
+
+        for inst in code_part.split(';'):
+            inst = inst.strip()
+            if not inst: continue
+
+            if ":" in inst:
+                lbl, remainder = inst.split(":", 1)
+                labels[lbl.strip()] = pc
+                inst = remainder.strip()
+                if not inst: continue
+
+            parts = inst.split(None, 1)
+            mnem = parts[0].upper()
+            operands = [o.strip() for o in parts[1].split(",")] if len(parts) > 1 else []
+
+            if mnem not in REG_OPCODES:
+                raise ValueError(f"Unknown opcode: {mnem} in line: {raw_line}")
+            opcode, fmt, kinds = REG_OPCODES[mnem]
+            if len(operands) != len(kinds):
+                raise ValueError(f"Opcode {mnem} expects {len(kinds)} operand(s) in line: {raw_line}")
+
+            parsed_ops.append({"mnem": mnem, "operands": operands,
+                               "size": REG_FORMAT_SIZE[fmt], "pc": pc, "line": line_no, "text": inst})
+            pc += REG_FORMAT_SIZE[fmt]
+
+    if symbols is not None:
+        symbols.update(labels=labels, ops=parsed_ops)
+
+    # Pass 2: 바이트코드 생성
+    code_labels = labels
+    labels = merge_labels(labels, rodata_labels)
+    body = []
+    for op in parsed_ops:
+        opcode, fmt, kinds = REG_OPCODES[op["mnem"]]
+        regs = {"d": 0, "a": 0, "b": 0}
+        imm = 0
+        for kind, tok in zip(kinds, op["operands"]):
+            if kind == "i":
+                imm = resolve_native(tok, labels) if op["mnem"] == "NATIVE" else resolve_imm(tok, labels)
+            else:
+                regs[kind] = parse_reg(tok)
+
+        body.append(opcode)
+        if fmt in ("R", "RR", "RI"):
+            body.append((regs["d"] << 4) | regs["a"])
+        if fmt == "RR":
+            body.append(regs["b"])
+        if fmt in ("RI", "I"):
+            body.append(imm & 0xFF)
+            body.append((imm >> 8) & 0xFF)
+
+    entry = labels.get(opts["entry"], 0) if "entry" in opts else 0
+    bound = stack_bound(parsed_ops, labels, stack_effect_v2, entry)
+    return build_image(0x02, opts, code_labels, body, bound, rodata)
+
+# ------------------------------------------------------------
+# 심볼 파일 (.sym) - 프로파일러 등에서 코드 오프셋 -> 소스 매핑
+#   L <offset> <label>
+#   I <offset> <size> <line> <text>
+# offset 은 헤더를 제외한 코드 오프셋 (JMP 대상 주소와 동일)
+# ------------------------------------------------------------
+def write_symbols(path, symbols):
+    with open(path, "w", encoding="utf-8") as f:
+        f.write("# vmtools symbols v1\n")
+        for lbl, off in sorted(symbols["labels"].items(), key=lambda kv: kv[1]):
+            f.write(f"L {off} {lbl}\n")
+        for op in symbols["ops"]:
+            f.write(f"I {op['pc']} {op['size']} {op['line']} {op['text']}\n")
+
+def read_symbols(path):
+    labels, insts = [], []
+    with open(path, "r", encoding="utf-8") as f:
+        for line in f:
+            if line.startswith("L "):
+                _, off, lbl = line.rstrip("\n").split(" ", 2)
+                labels.append((int(off), lbl))
+            elif line.startswith("I "):
+                _, off, size, line_no, text = line.rstrip("\n").split(" ", 4)
+                insts.append((int(off), int(size), int(line_no), text))
+    labels.sort()
+    insts.sort()
+    return labels, insts
+
+# ------------------------------------------------------------
+# 프로파일 (CMD_PROF 덤프) 분석
+# 덤프: [enabled u8][interval u8][samples u32][dropped u16][n u16] + n x [task u8][pc u16][count u16]
+# ------------------------------------------------------------
+PROF_TASK_IDLE = 0xFF
+
+def read_profile(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    interval = data[1]
+    samples = int.from_bytes(data[2:6], "little")
+    dropped = int.from_bytes(data[6:8], "little")
+    n = int.from_bytes(data[8:10], "little")
+    entries = []
+    for i in range(n):
+        e = data[10 + i * 5: 15 + i * 5]
+        entries.append((e[0], int.from_bytes(e[1:3], "little"), int.from_bytes(e[3:5], "little")))
+    return interval, samples, dropped, entries
+
+def print_profile(dump_path, sym_path, task=None):
+    interval, samples, dropped, entries = read_profile(dump_path)
+    labels, insts = read_symbols(sym_path)
+
+    print(f"Samples: {samples} (interval {interval} ms, dropped {dropped})")
+    other = {}
+    by_inst, by_label = {}, {}
+    for t, pc, count in entries:
+        if t == PROF_TASK_IDLE or t == 0 or (task is not None and t != task):
+            key = "idle" if t == PROF_TASK_IDLE else ("daemon" if t == 0 else f"task {t}")
+            other[key] = other.get(key, 0) + count
+            continue
+        # pc 는 다음 fetch 위치 -> (pc - 1) 을 포함하는 명령어에 귀속
+        target = max(pc - 1, 0)
+        inst = None
+        for ins in insts:
+            if ins[0] <= target < ins[0] + ins[1]: inst = ins; break
+        label = "<start>"
+        for off, lbl in labels:
+            if off <= target: label = lbl
+            else: break
+        ikey = inst if inst else (target, 0, 0, "?")
+        by_inst[ikey] = by_inst.get(ikey, 0) + count
+        by_label[label] = by_label.get(label, 0) + count
+
+    total = sum(by_label.values()) or 1
+    print("\n--- Flat profile by label ---")
+    for lbl, c in sorted(by_label.items(), key=lambda kv: -kv[1]):
+        print(f"{c * 100.0 / total:6.2f}% {c:8d}  {lbl}")
+    print("\n--- Hot instructions ---")
+    for ins, c in sorted(by_inst.items(), key=lambda kv: -kv[1])[:20]:
+        print(f"{c * 100.0 / total:6.2f}% {c:8d}  line {ins[2]:4d} @{ins[0]:5d}  {ins[3]}")
+    if other:
+        print("\n--- Not attributed ---")
+        for k, c in sorted(other.items(), key=lambda kv: -kv[1]):
+            print(f"{c:8d}  {k}")
+
+# ------------------------------------------------------------
+# ROM 이미지 (src/Rom.h, /rom 마운트)
+# 실행 파일들을 이어 붙인 PROGMEM 배열과 목록 표를 C++ 소스로 만듭니다.
+# 입력은 .bin (그대로) 또는 .asm (v1 로 어셈블). 이름은 확장자를 뺀 파일 이름.
+# 펌웨어는 ROM 실행 파일의 체크섬을 다시 보지 않으므로 여기서 검사합니다.
+# ------------------------------------------------------------
+ROM_NAME_MAX = 12  # NULL 포함 (src/Rom.h)
+
+def check_exec(name, data):
+    if len(data) < 4 or data[0] != 0xAD or (data[1] & 0x7F) not in (1, 2):
+        raise ValueError(f"{name}: not an executable (bad magic)")
+    if not (data[1] & EXEC_VER_EXT):
+        return
+    if len(data) < EXEC_EXT_HEADER_SIZE:
+        raise ValueError(f"{name}: truncated header")
+    hdr_size = data[4]
+    code_size, entry, rodata_len = (int.from_bytes(data[i:i + 2], "little") for i in (8, 10, 12))
+    if hdr_size + code_size + rodata_len != len(data) or entry >= code_size:
+        raise ValueError(f"{name}: bad layout")
+    if zlib.crc32(data[hdr_size:]) & 0xFFFFFFFF != int.from_bytes(data[16:20], "little"):
+        raise ValueError(f"{name}: checksum mismatch")
+
+def build_rom(out_path, inputs):
+    image, entries = bytearray(), []
+    for path in inputs:
+        name = os.path.splitext(os.path.basename(path))[0]
+        if len(name) >= ROM_NAME_MAX:
+            raise ValueError(f"{name}: name longer than {ROM_NAME_MAX - 1}")
+        if path.endswith(".asm"):
+            with open(path, "r", encoding="utf-8") as f:
+                data = assemble(f.readlines(), {})
+        else:
+            with open(path, "rb") as f:
+                data = f.read()
+        check_exec(name, data)
+        entries.append((name, len(image), len(data)))
+        image += data
+    if len(image) > 0xFFFF:
+        raise ValueError(f"ROM image too large ({len(image)} bytes, max 65535)")
+
+    lines = ["// 자동 생성 파일 - 직접 고치지 마세요 (python vmtools.py rom <out.cpp> <파일>...)",
+             "// " + " ".join(f"{n}({sz})" for n, _, sz in entries),
+             '#include "Rom.h"', "",
+             f"const uint8_t rom_count = {len(entries)};", ""]
+    lines.append("const RomEntry rom_dir[] PROGMEM = {")
+    for n, off, sz in entries:
+        lines.append(f'  {{"{n}", {off}, {sz}}},')
+    if not entries:
+        lines.append('  {"", 0, 0},')
+    lines += ["};", "", "const uint8_t rom_image[] PROGMEM = {"]
+    for i in range(0, len(image), 16):
+        lines.append("  " + ", ".join(f"0x{b:02X}" for b in image[i:i + 16]) + ",")
+    if not image:
+        lines.append("  0x00,")
+    lines.append("};")
+    with open(out_path, "w", encoding="utf-8", newline="\n") as f:
+        f.write("\n".join(lines) + "\n")
+    return entries, len(image)
 
 # ------------------------------------------------------------
 # Main
 # ------------------------------------------------------------
 if __name__ == "__main__":
-    if len(sys.argv) == 4 and sys.argv[1] == "asm":
+    if len(sys.argv) == 4 and sys.argv[1] in ("asm", "asm2"):
         try:
             # encoding='utf-8' 추가하여 인코딩 에러 방지
             with open(sys.argv[2], "r", encoding="utf-8") as f: 
                 lines = f.readlines()
             
-            code = assemble(lines)
+            symbols = {}
+            if sys.argv[1] == "asm":
+                code = assemble(lines, symbols)
+            else:
+                code = assemble_reg(lines, symbols)
             
             with open(sys.argv[3], "wb") as f: 
                 f.write(code)
+
+            sym_path = os.path.splitext(sys.argv[3])[0] + ".sym"
+            write_symbols(sym_path, symbols)
             
             print(f"[Success] Generated {sys.argv[3]} ({len(code)} bytes)")
             
         except Exception as e: 
             print(f"[Error] {e}")
+    elif len(sys.argv) >= 3 and sys.argv[1] == "rom":
+        try:
+            entries, size = build_rom(sys.argv[2], sys.argv[3:])
+            print(f"[Success] Generated {sys.argv[2]} ({len(entries)} files, {size} bytes)")
+        except Exception as e:
+            print(f"[Error] {e}")
+            sys.exit(1)
+    elif len(sys.argv) in (4, 5) and sys.argv[1] == "prof":
+        print_profile(sys.argv[2], sys.argv[3], int(sys.argv[4]) if len(sys.argv) == 5 else None)
     else:
-        print("Usage: python vmtools.py asm <source.asm> <out.bin>")
\ No newline at end of file
+        print("Usage: python vmtools.py asm <source.asm> <out.bin>")
+        print("       python vmtools.py asm2 <source.asm> <out.bin>   (v2 register bytecode)")
+        print("       python vmtools.py prof <prof.bin> <prog.sym> [task_id]")
+        print("       python vmtools.py rom <out.cpp> <prog.bin|prog.asm>...   (/rom PROGMEM image)")
+        print("  source directives: # @heap N, # @stack N, # @entry LABEL, # @preload")
\ No newline at end of file